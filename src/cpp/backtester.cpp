@@ -1,40 +1,189 @@
 #include "backtester.h"
+#include "mapped_file.h"
+#include "signal_file.h"
+#include "timestamp.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <charconv>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
 
 Backtester::Backtester() 
     : m_initialCapital(10000.0), 
-      m_cash(10000.0), 
-      m_position(0),
+      m_account{10000.0, 0},
       m_slippage(0.0005),
       m_latency(0.0) {}
 
 Backtester::Backtester(double initialCapital, double slippage, double latency) 
     : m_initialCapital(initialCapital), 
-      m_cash(initialCapital), 
-      m_position(0),
+      m_account{initialCapital, 0},
       m_slippage(slippage),
       m_latency(latency) {}
 
-bool Backtester::loadSignalsFromCSV(const std::string& filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << filePath << std::endl;
-        return false;
+Backtester::Backtester(double initialCapital, double slippage, double latency, std::pmr::memory_resource* resource)
+    : m_initialCapital(initialCapital),
+      m_account{initialCapital, 0},
+      m_slippage(slippage),
+      m_latency(latency),
+      m_equity(resource),
+      m_trades(resource),
+      m_drawdowns(resource),
+      m_returns(resource),
+      m_changes(resource) {}
+
+namespace {
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+bool parseDouble(const char* first, const char* last, double& value) {
+    return std::from_chars(first, last, value).ec == std::errc();
+}
+#else
+// Fallback for standard libraries without floating-point from_chars
+bool parseDouble(const char* first, const char* last, double& value) {
+    char buffer[64];
+    size_t length = std::min(static_cast<size_t>(last - first), sizeof(buffer) - 1);
+    std::memcpy(buffer, first, length);
+    buffer[length] = '\0';
+    char* end = nullptr;
+    value = std::strtod(buffer, &end);
+    return end != buffer;
+}
+#endif
+
+bool parseInt(const char* first, const char* last, int& value) {
+    return std::from_chars(first, last, value).ec == std::errc();
+}
+
+// Skip leading blanks the way std::stod/std::stoi do
+const char* skipBlanks(const char* first, const char* last) {
+    while (first != last && (*first == ' ' || *first == '\t')) {
+        ++first;
     }
+    return first;
+}
 
+// Return the end of the field starting at first (next ',' or end of line)
+const char* findFieldEnd(const char* first, const char* last) {
+    const char* comma = static_cast<const char*>(std::memchr(first, ',', last - first));
+    return comma != nullptr ? comma : last;
+}
+
+} // namespace
+
+void Backtester::resetForLoad() {
     // Clear previous data
-    m_signals.clear();
+    m_signals = SignalFrame();
+    m_fillRows.reset();
     m_equity.clear();
     m_drawdowns.clear();
     
     // Reset cash and position
-    m_cash = m_initialCapital;
-    m_position = 0;
+    m_account = Account{m_initialCapital, 0};
+}
 
+bool Backtester::loadSignalsFromCSV(const std::string& filePath) {
+    MappedFile file;
+    if (!file.open(filePath)) {
+        // Mapping is unavailable, use the stream-based loader
+        return loadSignalsFromCSVStream(filePath);
+    }
+    
+    return parseSignalsBuffer(file.data(), file.size());
+}
+
+bool Backtester::loadSignalsFromCSVMapped(const std::string& filePath) {
+    MappedFile file;
+    if (!file.open(filePath)) {
+        std::cerr << "Error: Could not map file " << filePath << std::endl;
+        return false;
+    }
+    
+    return parseSignalsBuffer(file.data(), file.size());
+}
+
+bool Backtester::parseSignalsBuffer(const char* data, size_t size) {
+    resetForLoad();
+    
+    const char* cursor = data;
+    const char* const bufferEnd = data + size;
+    
+    // Skip the header
+    const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', size));
+    cursor = newline != nullptr ? newline + 1 : bufferEnd;
+    
+    std::vector<int64_t> timestamps;
+    std::vector<double> prices;
+    std::vector<int8_t> signals;
+    
+    // Rough row estimate from the first data line to avoid regrowth
+    newline = static_cast<const char*>(std::memchr(cursor, '\n', bufferEnd - cursor));
+    if (newline != nullptr && newline > cursor) {
+        size_t estimate = static_cast<size_t>(bufferEnd - cursor) / static_cast<size_t>(newline - cursor + 1) + 1;
+        timestamps.reserve(estimate);
+        prices.reserve(estimate);
+        signals.reserve(estimate);
+    }
+    
+    while (cursor < bufferEnd) {
+        newline = static_cast<const char*>(std::memchr(cursor, '\n', bufferEnd - cursor));
+        const char* lineEnd = newline != nullptr ? newline : bufferEnd;
+        const char* next = newline != nullptr ? newline + 1 : bufferEnd;
+        
+        // Tolerate CRLF line endings
+        if (lineEnd > cursor && lineEnd[-1] == '\r') {
+            --lineEnd;
+        }
+        
+        if (lineEnd == cursor) {
+            cursor = next;
+            continue;
+        }
+        
+        // Parse CSV row
+        const char* timestampEnd = findFieldEnd(cursor, lineEnd);
+        const char* priceBegin = timestampEnd != lineEnd ? timestampEnd + 1 : lineEnd;
+        const char* priceEnd = findFieldEnd(priceBegin, lineEnd);
+        const char* signalBegin = priceEnd != lineEnd ? priceEnd + 1 : lineEnd;
+        const char* signalEnd = findFieldEnd(signalBegin, lineEnd);
+        
+        int64_t timestamp = 0;
+        double price = 0.0;
+        int signal = 0;
+        if (parseTimestamp(cursor, timestampEnd, timestamp) &&
+            parseDouble(skipBlanks(priceBegin, priceEnd), priceEnd, price) &&
+            parseInt(skipBlanks(signalBegin, signalEnd), signalEnd, signal)) {
+            // Add to signals
+            timestamps.push_back(timestamp);
+            prices.push_back(price);
+            signals.push_back(static_cast<int8_t>(signal));
+        } else {
+            std::cerr << "Error parsing line: " << std::string(cursor, lineEnd) << std::endl;
+        }
+        
+        cursor = next;
+    }
+    
+    m_signals = SignalFrame(std::move(timestamps), std::move(prices), std::move(signals));
+    return !m_signals.empty();
+}
+
+bool Backtester::loadSignalsFromCSVStream(const std::string& filePath) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filePath << std::endl;
+        return false;
+    }
+    
+    resetForLoad();
+    
+    std::vector<int64_t> timestamps;
+    std::vector<double> prices;
+    std::vector<int8_t> signals;
+    
     // Read the header
     std::string line;
     std::getline(file, line);
@@ -50,150 +199,167 @@ bool Backtester::loadSignalsFromCSV(const std::string& filePath) {
         std::getline(ss, signalStr, ',');
         
         try {
+            int64_t time = 0;
+            if (!parseTimestamp(timestamp.data(), timestamp.data() + timestamp.size(), time)) {
+                throw std::invalid_argument("invalid timestamp");
+            }
             double price = std::stod(priceStr);
             int signal = std::stoi(signalStr);
             
             // Add to signals
-            m_signals.push_back({timestamp, price, signal});
+            timestamps.push_back(time);
+            prices.push_back(price);
+            signals.push_back(static_cast<int8_t>(signal));
         } catch (const std::exception& e) {
             std::cerr << "Error parsing line: " << line << " - " << e.what() << std::endl;
         }
     }
     
     file.close();
+    m_signals = SignalFrame(std::move(timestamps), std::move(prices), std::move(signals));
     return !m_signals.empty();
 }
 
+bool Backtester::loadSignalsFromBinary(const std::string& filePath) {
+    resetForLoad();
+    
+    SignalFrame frame;
+    if (!SignalFile::read(filePath, frame)) {
+        return false;
+    }
+    
+    m_signals = frame;
+    return !m_signals.empty();
+}
+
+bool Backtester::loadSignalsFromFile(const std::string& filePath) {
+    if (SignalFile::isSignalFile(filePath)) {
+        return loadSignalsFromBinary(filePath);
+    }
+    return loadSignalsFromCSV(filePath);
+}
+
+void Backtester::setSignals(const SignalFrame& signals) {
+    resetForLoad();
+    m_signals = signals;
+}
+
+void Backtester::setFillIndex(std::shared_ptr<const std::vector<size_t>> fillRows) {
+    if (fillRows && fillRows->size() != m_signals.size()) {
+        throw std::invalid_argument("Fill index does not match the loaded signals");
+    }
+    m_fillRows = std::move(fillRows);
+}
+
+const SignalFrame& Backtester::getSignals() const {
+    return m_signals;
+}
+
 void Backtester::runBacktest() {
     if (m_signals.empty()) {
         std::cerr << "Error: No signals loaded" << std::endl;
         return;
     }
     
+    // Each latency policy gets its own inlined loop
+    const int64_t latencyNanos = secondsToNanos(m_latency);
+    if (latencyNanos <= 0) {
+        runWith(NoLatency());
+    } else if (m_fillRows) {
+        runWith(TableLatency(m_fillRows->data()));
+    } else {
+        runWith(SearchLatency(latencyNanos));
+    }
+}
+
+template <typename LatencyModel>
+void Backtester::runWith(LatencyModel latency) {
     // Initialize tracking variables
-    m_cash = m_initialCapital;
-    m_position = 0;
+    m_account = Account{m_initialCapital, 0};
+    m_trades.clear();
+    m_metrics = MetricsAccumulator(m_initialCapital);
+    
+    const size_t numSignals = m_signals.size();
+    const int8_t* signals = m_signals.signals();
+    
+    // Size every output buffer once so the loop never allocates
+    // (repeated runs over the same frame reuse the buffers)
+    m_equity.resize(numSignals);
+    m_drawdowns.resize(numSignals);
+    m_returns.resize(numSignals);
+    double* equityOut = m_equity.data();
+    double* drawdownsOut = m_drawdowns.data();
+    double* returnsOut = m_returns.data();
+    
+    // Only rows where the signal changes need the execution logic; every
+    // trade needs one, so their count also bounds the trade count
+    m_changes.resize(countSignalChanges(signals, numSignals, 0));
+    findSignalChanges(signals, numSignals, 0, m_changes.data());
+    m_trades.reserve(m_changes.size());
+    
+    ExecutionEngine<ProportionalSlippage, LatencyModel, AllInSizing> engine(ProportionalSlippage{m_slippage}, latency);
+    engine.runChanges(m_signals, m_account, m_changes.data(), m_changes.size(),
+                      [this](const TradeRecord& trade) { m_trades.push_back(trade); }, equityOut);
+    
+    // Drawdown and return statistics in one blocked, vectorized post-pass
+    // (cache-sized blocks inside updateSeries) rather than per row in the
+    // loop above, which only visits the rows where the signal changes
+    m_metrics.updateSeries(equityOut, numSignals, drawdownsOut, returnsOut);
+}
+
+void Backtester::executeSignal(int signal, double basePrice, int64_t timestamp) {
+    ExecutionEngine<ProportionalSlippage, NoLatency, AllInSizing> engine(ProportionalSlippage{m_slippage});
+    engine.execute(m_account, signal, basePrice, timestamp,
+                   [this](const TradeRecord& trade) { m_trades.push_back(trade); });
+}
+
+void Backtester::beginStream() {
+    m_account = Account{m_initialCapital, 0};
     m_equity.clear();
     m_trades.clear();
     m_drawdowns.clear();
+    m_returns.clear();
     
-    double lastEquity = m_initialCapital;
-    double highWaterMark = m_initialCapital;
-    int currentSignal = 0;
+    m_stream = StreamState();
+    m_metrics = MetricsAccumulator(m_initialCapital);
+}
+
+void Backtester::onSignal(int64_t timestamp, double price, int signal) {
+    // Fill an order whose latency has elapsed
+    if (m_stream.orderPending && timestamp >= m_stream.pendingFillTime) {
+        executeSignal(m_stream.pendingSignal, price, timestamp);
+        m_stream.orderPending = false;
+    }
     
-    // Process each signal
-    for (size_t i = 0; i < m_signals.size(); ++i) {
-        const auto& signal = m_signals[i];
-        
-        // Check if signal has changed
-        if (signal.signal != currentSignal) {
-            // Apply latency if specified
-            double effectivePrice = signal.price;
-            if (m_latency > 0.0) {
-                // Find the price after latency
-                size_t latencySteps = static_cast<size_t>(m_latency * 10);  // Assume 0.1 second per step
-                size_t nextIdx = std::min(i + latencySteps, m_signals.size() - 1);
-                effectivePrice = m_signals[nextIdx].price;
-            }
-            
-            // Apply slippage
-            if (signal.signal == 1) {  // Buy
-                effectivePrice *= (1.0 + m_slippage);
-            } else {  // Sell
-                effectivePrice *= (1.0 - m_slippage);
-            }
-            
-            // Execute trade
-            if (signal.signal == 1 && m_position == 0) {  // Buy
-                // Calculate how many shares we can buy
-                int shares = static_cast<int>(m_cash / effectivePrice);
-                if (shares > 0) {
-                    m_position = shares;
-                    m_cash -= shares * effectivePrice;
-                    
-                    // Record trade
-                    m_trades.push_back({
-                        signal.timestamp,
-                        "BUY",
-                        shares,
-                        effectivePrice,
-                        shares * effectivePrice
-                    });
-                }
-            } else if (signal.signal == 0 && m_position > 0) {  // Sell
-                double proceeds = m_position * effectivePrice;
-                
-                // Record trade
-                m_trades.push_back({
-                    signal.timestamp,
-                    "SELL",
-                    m_position,
-                    effectivePrice,
-                    proceeds
-                });
-                
-                m_cash += proceeds;
-                m_position = 0;
-            }
-            
-            currentSignal = signal.signal;
+    // Check if signal has changed
+    if (signal != m_stream.currentSignal) {
+        if (m_latency > 0.0) {
+            m_stream.orderPending = true;
+            m_stream.pendingSignal = signal;
+            m_stream.pendingFillTime = timestamp + secondsToNanos(m_latency);
+        } else {
+            executeSignal(signal, price, timestamp);
         }
-        
-        // Calculate equity at this point
-        double equity = m_cash;
-        if (m_position > 0) {
-            equity += m_position * signal.price;
-        }
-        
-        // Record equity
-        m_equity.push_back({signal.timestamp, equity});
-        
-        // Calculate drawdown
-        highWaterMark = std::max(highWaterMark, equity);
-        double drawdown = (highWaterMark - equity) / highWaterMark * 100.0;
-        m_drawdowns.push_back(drawdown);
-        
-        // Calculate returns
-        double dailyReturn = equity / lastEquity - 1.0;
-        m_returns.push_back(dailyReturn);
-        lastEquity = equity;
+        m_stream.currentSignal = signal;
     }
+    
+    // Update drawdown and return statistics
+    m_metrics.update(m_account.equity(price));
 }
 
-BacktestResults Backtester::getResults() const {
+BacktestResults Backtester::snapshot() const {
     BacktestResults results;
     
-    if (m_equity.empty()) {
+    if (m_metrics.count() == 0) {
         return results;
     }
     
-    // Calculate final return
-    double finalEquity = m_equity.back().equity;
-    results.finalEquity = finalEquity;
-    results.finalReturn = (finalEquity / m_initialCapital - 1.0) * 100.0;
-    
-    // Calculate max drawdown
-    results.maxDrawdown = *std::max_element(m_drawdowns.begin(), m_drawdowns.end());
-    
-    // Calculate Sharpe ratio
-    double totalReturn = 0.0;
-    double totalRisk = 0.0;
-    
-    // Skip first entry which has no return
-    for (size_t i = 0; i < m_returns.size(); ++i) {
-        totalReturn += m_returns[i];
-        totalRisk += m_returns[i] * m_returns[i];
-    }
-    
-    double meanReturn = totalReturn / m_returns.size();
-    double stdDev = std::sqrt(totalRisk / m_returns.size() - meanReturn * meanReturn);
+    results.finalEquity = m_metrics.lastEquity();
+    results.finalReturn = (results.finalEquity / m_initialCapital - 1.0) * 100.0;
+    results.maxDrawdown = m_metrics.maxDrawdown();
     
     // Annualized Sharpe ratio (assuming daily returns)
-    if (stdDev > 0) {
-        results.sharpeRatio = (meanReturn * 252) / (stdDev * std::sqrt(252));
-    } else {
-        results.sharpeRatio = 0;
-    }
+    results.sharpeRatio = m_metrics.sharpeRatio();
     
     // Trading statistics
     results.totalTrades = m_trades.size();
@@ -201,6 +367,56 @@ BacktestResults Backtester::getResults() const {
     return results;
 }
 
+BacktestResults Backtester::getResults() const {
+    if (m_equity.empty()) {
+        return BacktestResults();
+    }
+    
+    // Metrics are accumulated inside the backtest loop
+    return snapshot();
+}
+
+std::vector<EquityPoint> Backtester::getEquityCurve() const {
+    std::vector<EquityPoint> curve;
+    curve.reserve(m_equity.size());
+    for (size_t i = 0; i < m_equity.size(); ++i) {
+        curve.push_back({m_signals.timestamp(i), m_equity[i]});
+    }
+    return curve;
+}
+
+const std::pmr::vector<double>& Backtester::getEquity() const {
+    return m_equity;
+}
+
+const std::pmr::vector<double>& Backtester::getDrawdowns() const {
+    return m_drawdowns;
+}
+
+const std::pmr::vector<double>& Backtester::getReturns() const {
+    return m_returns;
+}
+
+const std::pmr::vector<TradeRecord>& Backtester::getTrades() const {
+    return m_trades;
+}
+
+BacktestSeries Backtester::releaseSeries() {
+    // Move assignment copies instead when the allocators' resources differ
+    BacktestSeries series;
+    series.signals = m_signals;
+    series.equity = std::move(m_equity);
+    series.drawdowns = std::move(m_drawdowns);
+    series.returns = std::move(m_returns);
+    series.trades = std::move(m_trades);
+    
+    m_equity.clear();
+    m_drawdowns.clear();
+    m_returns.clear();
+    m_trades.clear();
+    return series;
+}
+
 void Backtester::printResults() const {
     BacktestResults results = getResults();
     
@@ -217,7 +433,7 @@ void Backtester::printResults() const {
     size_t numTradesToShow = std::min(m_trades.size(), static_cast<size_t>(5));
     for (size_t i = 0; i < numTradesToShow; ++i) {
         const auto& trade = m_trades[i];
-        std::cout << trade.timestamp << ": " << trade.action 
+        std::cout << formatTimestamp(trade.timestamp) << ": " << sideName(trade.side) 
                   << " " << trade.shares << " shares @ $" << trade.price 
                   << " = $" << trade.value << std::endl;
     }
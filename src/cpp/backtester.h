@@ -1,35 +1,36 @@
 #ifndef BACKTESTER_H
 #define BACKTESTER_H
 
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <vector>
-
-/**
- * Structure to hold signal data from CSV
- */
-struct Signal {
-    std::string timestamp;
-    double price;
-    int signal;  // 0 = no position/sell, 1 = buy
-};
+#include "execution_engine.h"
+#include "metrics_accumulator.h"
+#include "signal_frame.h"
+#include "trade_record.h"
 
 /**
  * Structure to hold equity value over time
+ * 
+ * Timestamps are nanoseconds since the Unix epoch; use formatTimestamp()
+ * (timestamp.h) to turn them into text at the output boundary.
  */
 struct EquityPoint {
-    std::string timestamp;
+    int64_t timestamp;
     double equity;
 };
 
 /**
- * Structure to hold trade information
+ * Structure to hold the per-row output series of a backtest
  */
-struct Trade {
-    std::string timestamp;
-    std::string action;  // "BUY" or "SELL"
-    int shares;
-    double price;
-    double value;
+struct BacktestSeries {
+    SignalFrame signals;                  // Timestamps and prices for each row
+    std::pmr::vector<double> equity;      // Equity per row
+    std::pmr::vector<double> drawdowns;   // Drawdown percentage per row
+    std::pmr::vector<double> returns;     // Simple return per row
+    std::pmr::vector<TradeRecord> trades;
 };
 
 /**
@@ -58,23 +59,134 @@ public:
      * 
      * @param initialCapital Initial capital for the backtest
      * @param slippage Slippage parameter (0.001 = 0.1%)
-     * @param latency Latency parameter in seconds
+     * @param latency Latency in seconds; an order fills at the first row whose
+     *                timestamp is at or after the signal change plus the latency
      */
     Backtester(double initialCapital, double slippage, double latency);
     
+    /**
+     * Constructor with a memory resource for the per-run buffers
+     * 
+     * The equity, drawdown, return, trade and scratch buffers are allocated
+     * from resource (e.g. a RunArena), which must outlive the backtester.
+     * 
+     * @param initialCapital Initial capital for the backtest
+     * @param slippage Slippage parameter (0.001 = 0.1%)
+     * @param latency Latency in seconds
+     * @param resource Memory resource for the per-run buffers
+     */
+    Backtester(double initialCapital, double slippage, double latency, std::pmr::memory_resource* resource);
+    
     /**
      * Load signals from a CSV file
      * 
+     * Uses the memory-mapped loader and falls back to stream reading
+     * if the file cannot be mapped.
+     * 
      * @param filePath Path to the CSV file
      * @return True if successful, false otherwise
      */
     bool loadSignalsFromCSV(const std::string& filePath);
     
+    /**
+     * Load signals from a CSV file by scanning a memory mapping in place
+     * 
+     * @param filePath Path to the CSV file
+     * @return True if successful, false otherwise (including when the
+     *         file cannot be mapped)
+     */
+    bool loadSignalsFromCSVMapped(const std::string& filePath);
+    
+    /**
+     * Load signals from a CSV file line by line using std::ifstream
+     * 
+     * @param filePath Path to the CSV file
+     * @return True if successful, false otherwise
+     */
+    bool loadSignalsFromCSVStream(const std::string& filePath);
+    
+    /**
+     * Load signals from a binary signal file (see signal_file.h)
+     * 
+     * The file is memory-mapped and its columns are used in place.
+     * 
+     * @param filePath Path to the signal file
+     * @return True if successful, false otherwise
+     */
+    bool loadSignalsFromBinary(const std::string& filePath);
+    
+    /**
+     * Load signals from a binary signal file or a CSV file
+     * 
+     * The format is detected from the file's magic bytes.
+     * 
+     * @param filePath Path to the file
+     * @return True if successful, false otherwise
+     */
+    bool loadSignalsFromFile(const std::string& filePath);
+    
+    /**
+     * Use an already loaded signal frame
+     * 
+     * The frame's columns are shared, not copied.
+     * 
+     * @param signals Signal frame
+     */
+    void setSignals(const SignalFrame& signals);
+    
+    /**
+     * Use a precomputed fill-row table for the latency
+     * 
+     * The table must come from getSignals().forwardIndex() with this
+     * backtester's latency; runBacktest then reads fill rows from it instead
+     * of searching the timestamps. Loading new signals drops the table.
+     * 
+     * @param fillRows Fill row for every signal row (nullptr = search)
+     * @throws std::invalid_argument if the table does not match the signals
+     */
+    void setFillIndex(std::shared_ptr<const std::vector<size_t>> fillRows);
+    
+    /**
+     * Get the loaded signals
+     * 
+     * @return Signal frame
+     */
+    const SignalFrame& getSignals() const;
+    
     /**
      * Run the backtest
      */
     void runBacktest();
     
+    /**
+     * Start a streaming session
+     * 
+     * Resets the account and the incremental statistics. Ticks are then
+     * fed one at a time with onSignal() and nothing is stored per tick.
+     */
+    void beginStream();
+    
+    /**
+     * Process one tick in streaming mode
+     * 
+     * A signal change becomes an order that fills at the first tick whose
+     * timestamp is at or after the change time plus the latency (the same
+     * tick when latency is 0). A newer signal change replaces an unfilled
+     * order. Equity, drawdown and return statistics update in O(1).
+     * 
+     * @param timestamp Tick time in nanoseconds since the Unix epoch
+     * @param price Price at this tick
+     * @param signal Signal (0 = no position/sell, 1 = buy)
+     */
+    void onSignal(int64_t timestamp, double price, int signal);
+    
+    /**
+     * Get the current streaming results in O(1)
+     * 
+     * @return BacktestResults structure
+     */
+    BacktestResults snapshot() const;
+    
     /**
      * Get the backtest results
      * 
@@ -82,23 +194,118 @@ public:
      */
     BacktestResults getResults() const;
     
+    /**
+     * Get the equity curve with timestamps
+     * 
+     * @return Vector of equity points, one per signal row
+     */
+    std::vector<EquityPoint> getEquityCurve() const;
+    
+    /**
+     * Get the equity value for each signal row
+     * 
+     * @return Vector of equity values
+     */
+    const std::pmr::vector<double>& getEquity() const;
+    
+    /**
+     * Get the drawdown percentage for each signal row
+     * 
+     * @return Vector of drawdowns
+     */
+    const std::pmr::vector<double>& getDrawdowns() const;
+    
+    /**
+     * Get the simple return for each signal row
+     * 
+     * @return Vector of returns
+     */
+    const std::pmr::vector<double>& getReturns() const;
+    
+    /**
+     * Get the executed trades
+     * 
+     * @return Vector of trade records
+     */
+    const std::pmr::vector<TradeRecord>& getTrades() const;
+    
+    /**
+     * Move the output series out of the backtester
+     * 
+     * The series are always returned on the default memory resource: they
+     * are moved without copying unless the backtester uses another resource.
+     * The backtester's series are left empty until the next runBacktest.
+     * 
+     * @return BacktestSeries structure
+     */
+    BacktestSeries releaseSeries();
+    
     /**
      * Print the backtest results to standard output
      */
     void printResults() const;
     
 private:
+    /**
+     * Clear loaded data and reset the account before a new load
+     */
+    void resetForLoad();
+    
+    /**
+     * Parse CSV signal rows from an in-memory buffer
+     * 
+     * @param data Start of the buffer
+     * @param size Size of the buffer in bytes
+     * @return True if at least one signal was parsed
+     */
+    bool parseSignalsBuffer(const char* data, size_t size);
+    
+    /**
+     * Run the backtest loop with the given latency policy
+     * 
+     * @param latency Latency policy for the execution engine
+     */
+    template <typename LatencyModel>
+    void runWith(LatencyModel latency);
+    
+    /**
+     * Apply slippage and execute a trade if the signal calls for one
+     * 
+     * @param signal Target signal (1 = buy, 0 = sell)
+     * @param basePrice Execution price before slippage
+     * @param timestamp Trade time in nanoseconds since the Unix epoch
+     */
+    void executeSignal(int signal, double basePrice, int64_t timestamp);
+    
+    /**
+     * Incremental state for streaming mode
+     */
+    struct StreamState {
+        int currentSignal = 0;
+        bool orderPending = false;
+        int pendingSignal = 0;
+        int64_t pendingFillTime = 0;
+    };
+    
     double m_initialCapital;
-    double m_cash;
-    int m_position;
+    Account m_account;
     double m_slippage;
     double m_latency;
     
-    std::vector<Signal> m_signals;
-    std::vector<EquityPoint> m_equity;
-    std::vector<Trade> m_trades;
-    std::vector<double> m_drawdowns;
-    std::vector<double> m_returns;
+    SignalFrame m_signals;
+    std::shared_ptr<const std::vector<size_t>> m_fillRows;  // Optional latency fill table
+    
+    // Per-run buffers, allocated from the constructor's memory resource
+    std::pmr::vector<double> m_equity;  // Equity per signal row (timestamps live in m_signals)
+    std::pmr::vector<TradeRecord> m_trades;
+    std::pmr::vector<double> m_drawdowns;
+    std::pmr::vector<double> m_returns;
+    std::pmr::vector<size_t> m_changes;  // Rows where the signal changes (scratch, reused across runs)
+    
+    // Updated per bar by the stream loop, and by runBacktest in a blocked
+    // post-pass over the equity curve once the trades are executed
+    MetricsAccumulator m_metrics;
+    StreamState m_stream;
 };
 
 #endif // BACKTESTER_H
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "batch_backtest.h"
+#include "run_arena.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <numeric>
+
+namespace {
+
+// Bytes per row in a binary signal file, used to size in-memory jobs
+constexpr uint64_t kBytesPerRow = sizeof(int64_t) + sizeof(double) + sizeof(int8_t);
+
+// Rough cost of a job, in bytes of signal data to load and simulate
+uint64_t estimateCost(const BatchJob& job) {
+    if (job.path.empty()) {
+        return job.signals.size() * kBytesPerRow;
+    }
+    
+    std::error_code error;
+    uintmax_t size = std::filesystem::file_size(job.path, error);
+    return error ? 0 : static_cast<uint64_t>(size);
+}
+
+} // namespace
+
+BatchBacktest::BatchBacktest(const SweepConfig& config)
+    : m_config(config) {}
+
+std::vector<BatchResult> BatchBacktest::run(const std::vector<BatchJob>& jobs, size_t numThreads) const {
+    std::vector<BatchResult> results(jobs.size());
+    if (jobs.empty()) {
+        return results;
+    }
+    
+    // Largest jobs first, so the batch does not end waiting on one big file
+    std::vector<uint64_t> costs(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        costs[i] = estimateCost(jobs[i]);
+    }
+    std::vector<size_t> order(jobs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&costs](size_t a, size_t b) { return costs[a] > costs[b]; });
+    
+    ThreadPool pool(std::min(numThreads == 0 ? std::thread::hardware_concurrency() : numThreads, jobs.size()));
+    // Run buffers come from a per-worker arena that is reset after each job
+    std::vector<RunArena> arenas(pool.size());
+    pool.parallelForSlots(order.size(), [&](size_t k, size_t slot) {
+        const size_t i = order[k];
+        const BatchJob& job = jobs[i];
+        {
+            // Each job loads and runs on the same worker with its own account state
+            Backtester backtester(m_config.initialCapital, m_config.slippage, m_config.latency, &arenas[slot]);
+            bool loaded = false;
+            if (job.path.empty()) {
+                backtester.setSignals(job.signals);
+                loaded = !job.signals.empty();
+            } else {
+                loaded = backtester.loadSignalsFromFile(job.path);
+            }
+            
+            BatchResult& result = results[i];
+            result.loaded = loaded;
+            if (loaded) {
+                backtester.runBacktest();
+                result.rows = backtester.getSignals().size();
+                result.results = backtester.getResults();
+            }
+        }
+        arenas[slot].reset();
+    });
+    
+    return results;
+}
@@ -0,0 +1,61 @@
+#ifndef BATCH_BACKTEST_H
+#define BATCH_BACKTEST_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "backtester.h"       // For BacktestResults and SignalFrame
+#include "parameter_sweep.h"  // For SweepConfig
+
+/**
+ * One independent backtest in a batch: a signal file or in-memory signals
+ */
+struct BatchJob {
+    std::string path;     // CSV or binary signal file (empty = use signals)
+    SignalFrame signals;  // Already loaded signals, used when path is empty
+};
+
+/**
+ * Outcome of one batch job
+ */
+struct BatchResult {
+    bool loaded = false;      // False if the signals could not be loaded
+    size_t rows = 0;          // Number of signal rows
+    BacktestResults results;  // Default-constructed unless loaded
+};
+
+/**
+ * BatchBacktest class for running many independent single-symbol
+ * backtests with the same configuration in parallel
+ *
+ * Each job's load and simulation run together on one worker. Jobs are
+ * started largest first and handed out one at a time to whichever worker
+ * is free, so a long file neither waits behind short ones nor pins its
+ * worker while the rest sit idle.
+ */
+class BatchBacktest {
+public:
+    /**
+     * Constructor
+     * 
+     * @param config Capital, slippage and latency used for every job
+     */
+    explicit BatchBacktest(const SweepConfig& config);
+    
+    /**
+     * Run every job
+     * 
+     * A job whose signals cannot be loaded is reported with loaded = false
+     * and does not stop the others.
+     * 
+     * @param jobs Jobs to run
+     * @param numThreads Number of worker threads (0 = one per hardware thread)
+     * @return Results in the same order as jobs
+     */
+    std::vector<BatchResult> run(const std::vector<BatchJob>& jobs, size_t numThreads = 0) const;
+    
+private:
+    SweepConfig m_config;
+};
+
+#endif // BATCH_BACKTEST_H
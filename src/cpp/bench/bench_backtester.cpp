@@ -0,0 +1,528 @@
+/**
+ * Google Benchmark suite for the C++ engine.
+ *
+ * Every benchmark runs over synthetic series from 1e3 up to BENCH_MAX_ROWS
+ * rows and reports rows/sec (items_per_second) and time_per_row. Emit JSON
+ * for tracking with:
+ *
+ *   bench_backtester --benchmark_format=json --benchmark_out=bench_backtester.json
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include "bench_common.h"
+#include "backtester.h"
+#include "equity_kernels.h"
+#include "execution_engine.h"
+#include "indicator_engine.h"
+#include "metrics_accumulator.h"
+#include "parameter_sweep.h"
+#include "performance_metrics.h"
+#include "portfolio_backtester.h"
+#include "rolling_metrics.h"
+#include "run_arena.h"
+#include "trade_simulator.h"
+#include "walk_forward.h"
+
+// Count every heap allocation so the backtest loop can be checked for
+// steady-state allocations. The replacements are kept out of line so GCC
+// does not pair inlined new/delete calls with malloc/free and warn.
+static std::atomic<size_t> g_allocations{0};
+
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+BENCH_NOINLINE void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+BENCH_NOINLINE void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// std::pmr::new_delete_resource() allocates through the aligned forms
+BENCH_NOINLINE void* operator new(std::size_t size, std::align_val_t alignment) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+BENCH_NOINLINE void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+void BM_LoadCSVMapped(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const std::string path = bench::syntheticCSV(rows);
+    Backtester backtester;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(backtester.loadSignalsFromCSVMapped(path));
+    }
+    bench::setRowCounters(state, rows);
+    std::remove(path.c_str());
+}
+
+void BM_LoadCSVStream(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const std::string path = bench::syntheticCSV(rows);
+    Backtester backtester;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(backtester.loadSignalsFromCSVStream(path));
+    }
+    bench::setRowCounters(state, rows);
+    std::remove(path.c_str());
+}
+
+void BM_RunBacktest(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    Backtester backtester(10000.0, 0.0005, 0.0);
+    backtester.setSignals(bench::syntheticFrame(rows));
+    
+    // The first run sizes the buffers (test_allocations checks that later
+    // runs do not allocate)
+    backtester.runBacktest();
+    const size_t allocationsBefore = g_allocations.load();
+    for (auto _ : state) {
+        backtester.runBacktest();
+        benchmark::DoNotOptimize(backtester.getResults());
+    }
+    const size_t allocations = g_allocations.load() - allocationsBefore;
+    state.counters["allocations_per_run"] = benchmark::Counter(
+        static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    bench::setRowCounters(state, rows);
+}
+
+void BM_RunBacktestLatency(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const bool useTable = state.range(1) != 0;
+    Backtester backtester(10000.0, 0.0005, 5.0);  // 5 bars of latency
+    backtester.setSignals(bench::syntheticFrame(rows));
+    if (useTable) {
+        backtester.setFillIndex(std::make_shared<const std::vector<size_t>>(
+            backtester.getSignals().forwardIndex(secondsToNanos(5.0))));
+    }
+    for (auto _ : state) {
+        backtester.runBacktest();
+        benchmark::DoNotOptimize(backtester.getResults());
+    }
+    bench::setRowCounters(state, rows);
+}
+
+// A new backtester per run, as in a sweep (arg 1: 0 = heap buffers, 1 = RunArena)
+void BM_RunBacktestFresh(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const bool useArena = state.range(1) != 0;
+    const SignalFrame& frame = bench::syntheticFrame(rows);
+    RunArena arena;
+    
+    auto runOnce = [&] {
+        {
+            Backtester backtester = useArena ? Backtester(10000.0, 0.0005, 0.0, &arena) : Backtester(10000.0, 0.0005, 0.0);
+            backtester.setSignals(frame);
+            backtester.runBacktest();
+            benchmark::DoNotOptimize(backtester.getResults());
+        }
+        arena.reset();
+    };
+    
+    // The first run sizes the arena (test_allocations checks that later
+    // arena-backed runs do not allocate)
+    runOnce();
+    const size_t allocationsBefore = g_allocations.load();
+    for (auto _ : state) {
+        runOnce();
+    }
+    const size_t allocations = g_allocations.load() - allocationsBefore;
+    state.counters["allocations_per_run"] = benchmark::Counter(
+        static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    state.SetLabel(useArena ? "arena" : "heap");
+    bench::setRowCounters(state, rows);
+}
+
+// Sweep of 256 configurations; reports the arenas' heap allocations per run
+void BM_ParameterSweep(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    ParameterSweep sweep(bench::syntheticFrame(rows));
+    std::vector<double> slippages(64);
+    for (size_t i = 0; i < slippages.size(); ++i) {
+        slippages[i] = 0.0001 * static_cast<double>(i);
+    }
+    const std::vector<SweepConfig> configs = ParameterSweep::makeGrid({10000.0, 50000.0}, slippages, {0.0, 5.0});
+    ArenaStats stats;
+    size_t heapAllocations = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sweep.run(configs, 4, &stats));
+        heapAllocations += stats.heapAllocations;
+    }
+    state.counters["arena_heap_allocations_per_run"] = benchmark::Counter(
+        static_cast<double>(heapAllocations) / static_cast<double>(configs.size()), benchmark::Counter::kAvgIterations);
+    bench::setRowCounters(state, rows * configs.size());
+}
+
+// Latency policies for BM_ExecutionEngine (5 bars of latency when enabled)
+template <typename LatencyModel>
+LatencyModel makeLatency();
+
+template <>
+NoLatency makeLatency<NoLatency>() {
+    return NoLatency();
+}
+
+template <>
+SearchLatency makeLatency<SearchLatency>() {
+    return SearchLatency(5 * bench::kBarNanos);
+}
+
+template <typename SlippageModel, typename LatencyModel, typename SizingModel>
+void BM_ExecutionEngine(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const SignalFrame& frame = bench::syntheticFrame(rows);
+    for (auto _ : state) {
+        ExecutionEngine<SlippageModel, LatencyModel, SizingModel> engine(
+            SlippageModel(), makeLatency<LatencyModel>(), SizingModel());
+        Account account{10000.0, 0};
+        double equity = 0.0;
+        engine.run(frame, account,
+                   [](const TradeRecord& trade) { benchmark::DoNotOptimize(trade); },
+                   [&equity](size_t, double value) { equity = value; });
+        benchmark::DoNotOptimize(equity);
+    }
+    bench::setRowCounters(state, rows);
+}
+
+// Per-bar run() against change-only runChanges() as signals get sparser
+// (args: rows, flips per 10000 bars, 0 = per bar / 1 = changes only)
+void BM_SparseSignals(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const SignalFrame& frame = bench::syntheticFrame(rows, static_cast<double>(state.range(1)) / 10000.0);
+    const bool changesOnly = state.range(2) != 0;
+    std::vector<double> equity(rows);
+    std::vector<size_t> changes(countSignalChanges(frame.signals(), rows, 0));
+    for (auto _ : state) {
+        ExecutionEngine<ProportionalSlippage, NoLatency, AllInSizing> engine(ProportionalSlippage{0.0005});
+        Account account{10000.0, 0};
+        auto onFill = [](const TradeRecord& trade) { benchmark::DoNotOptimize(trade); };
+        if (changesOnly) {
+            findSignalChanges(frame.signals(), rows, 0, changes.data());
+            engine.runChanges(frame, account, changes.data(), changes.size(), onFill, equity.data());
+        } else {
+            engine.run(frame, account, onFill, [&equity](size_t i, double value) { equity[i] = value; });
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(changesOnly ? "changes" : "per-bar");
+    bench::setRowCounters(state, rows);
+}
+
+void BM_PortfolioBacktest(benchmark::State& state) {
+    const size_t times = static_cast<size_t>(state.range(0));
+    const size_t symbols = static_cast<size_t>(state.range(1));
+    PortfolioBacktester backtester(1000000.0, 0.0005, 0.0);
+    backtester.setPanel(bench::syntheticPanel(times, symbols));
+    for (auto _ : state) {
+        backtester.runBacktest();
+        benchmark::DoNotOptimize(backtester.getResults());
+    }
+    // Rows are (timestamp, symbol) cells
+    bench::setRowCounters(state, times * symbols);
+}
+
+void BM_SimulateTrades(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const SignalFrame& frame = bench::syntheticFrame(rows);
+    TradeSimulator simulator(0.0005, 0.0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simulator.simulateTrades(frame));
+    }
+    bench::setRowCounters(state, rows);
+}
+
+void BM_CalculateAllMetrics(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    std::vector<double> equity, returns;
+    bench::syntheticEquity(rows, equity, returns);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PerformanceMetrics::calculateAllMetrics(equity, returns, 10000.0));
+    }
+    bench::setRowCounters(state, rows);
+}
+
+// Points in the equity kernel benchmarks
+constexpr size_t kCurvePoints = 10000000;
+
+// Select the instruction set given as the benchmark argument, or skip
+bool useSimdLevel(benchmark::State& state) {
+    const SimdLevel level = static_cast<SimdLevel>(state.range(0));
+    if (level > detectSimdLevel()) {
+        state.SkipWithError("instruction set not supported on this CPU");
+        return false;
+    }
+    setSimdLevel(level);
+    state.SetLabel(simdLevelName(level));
+    return true;
+}
+
+// Drawdown and return bookkeeping one point at a time (the previous backtest loop)
+void BM_EquitySeriesPerPoint(benchmark::State& state) {
+    std::vector<double> equity, returns;
+    bench::syntheticEquity(kCurvePoints, equity, returns);
+    std::vector<double> drawdowns(kCurvePoints);
+    for (auto _ : state) {
+        MetricsAccumulator metrics(10000.0);
+        for (size_t i = 0; i < kCurvePoints; ++i) {
+            metrics.update(equity[i]);
+            drawdowns[i] = metrics.currentDrawdown();
+            returns[i] = metrics.lastReturn();
+        }
+        benchmark::DoNotOptimize(metrics.maxDrawdown());
+        benchmark::ClobberMemory();
+    }
+    bench::setRowCounters(state, kCurvePoints);
+}
+
+void BM_EquitySeries(benchmark::State& state) {
+    if (!useSimdLevel(state)) {
+        return;
+    }
+    std::vector<double> equity, returns;
+    bench::syntheticEquity(kCurvePoints, equity, returns);
+    std::vector<double> drawdowns(kCurvePoints);
+    for (auto _ : state) {
+        MetricsAccumulator metrics(10000.0);
+        metrics.updateSeries(equity.data(), kCurvePoints, drawdowns.data(), returns.data());
+        benchmark::DoNotOptimize(metrics.maxDrawdown());
+        benchmark::ClobberMemory();
+    }
+    setSimdLevel(detectSimdLevel());
+    bench::setRowCounters(state, kCurvePoints);
+}
+
+// Scalar running-peak loop with a division per point
+void BM_MaxDrawdownLoop(benchmark::State& state) {
+    std::vector<double> equity, returns;
+    bench::syntheticEquity(kCurvePoints, equity, returns);
+    for (auto _ : state) {
+        double maxDrawdown = 0.0;
+        double peak = equity[0];
+        for (double value : equity) {
+            if (value > peak) {
+                peak = value;
+            }
+            maxDrawdown = std::max(maxDrawdown, (peak - value) / peak * 100.0);
+        }
+        benchmark::DoNotOptimize(maxDrawdown);
+    }
+    bench::setRowCounters(state, kCurvePoints);
+}
+
+void BM_MaxDrawdown(benchmark::State& state) {
+    if (!useSimdLevel(state)) {
+        return;
+    }
+    std::vector<double> equity, returns;
+    bench::syntheticEquity(kCurvePoints, equity, returns);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PerformanceMetrics::calculateMaxDrawdown(equity));
+    }
+    setSimdLevel(detectSimdLevel());
+    bench::setRowCounters(state, kCurvePoints);
+}
+
+void BM_Returns(benchmark::State& state) {
+    if (!useSimdLevel(state)) {
+        return;
+    }
+    std::vector<double> equity, returns;
+    bench::syntheticEquity(kCurvePoints, equity, returns);
+    for (auto _ : state) {
+        computeReturns(equity.data(), kCurvePoints, 10000.0, returns.data());
+        benchmark::ClobberMemory();
+    }
+    setSimdLevel(detectSimdLevel());
+    bench::setRowCounters(state, kCurvePoints);
+}
+
+constexpr size_t kRollingPoints = 1000000;
+
+// Recomputes each bar's window from scratch: O(window) per bar
+void BM_RollingMetricsNaive(benchmark::State& state) {
+    const size_t window = static_cast<size_t>(state.range(0));
+    std::vector<double> equity, returns;
+    bench::syntheticEquity(kRollingPoints, equity, returns);
+    std::vector<double> volatility(kRollingPoints), sharpe(kRollingPoints), sortino(kRollingPoints), drawdown(kRollingPoints);
+    for (auto _ : state) {
+        for (size_t i = 0; i < kRollingPoints; ++i) {
+            MetricsAccumulator metrics;
+            double peak = 0.0;
+            for (size_t j = i >= window ? i - window : 0; j <= i; ++j) {
+                metrics.update(equity[j]);
+                peak = j + window > i ? std::max(peak, equity[j]) : peak;
+            }
+            volatility[i] = std::sqrt(metrics.variance()) * std::sqrt(252.0);
+            sharpe[i] = metrics.sharpeRatio();
+            sortino[i] = metrics.sortinoRatio();
+            drawdown[i] = (peak - equity[i]) / peak * 100.0;
+        }
+        benchmark::ClobberMemory();
+    }
+    bench::setRowCounters(state, kRollingPoints);
+}
+
+void BM_RollingMetrics(benchmark::State& state) {
+    RollingMetrics metrics(static_cast<size_t>(state.range(0)));
+    std::vector<double> equity, returns;
+    bench::syntheticEquity(kRollingPoints, equity, returns);
+    std::vector<double> volatility(kRollingPoints), sharpe(kRollingPoints), sortino(kRollingPoints), drawdown(kRollingPoints);
+    for (auto _ : state) {
+        metrics.compute(equity.data(), kRollingPoints, {volatility.data(), sharpe.data(), sortino.data(), drawdown.data()});
+        benchmark::ClobberMemory();
+    }
+    bench::setRowCounters(state, kRollingPoints);
+}
+
+void BM_ComputeIndicators(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const SignalFrame& frame = bench::syntheticFrame(rows);
+    std::vector<double> features(rows * IndicatorEngine::kFeatureCount);
+    for (auto _ : state) {
+        IndicatorEngine::compute(frame.prices(), rows, features.data());
+        benchmark::ClobberMemory();
+    }
+    bench::setRowCounters(state, rows);
+}
+
+// One live bar at a time: the cost per bar does not depend on the history length
+void BM_IndicatorStateUpdate(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const SignalFrame& frame = bench::syntheticFrame(rows);
+    double row[IndicatorEngine::kFeatureCount];
+    for (auto _ : state) {
+        IndicatorState indicators;
+        for (size_t i = 0; i < rows; ++i) {
+            indicators.update(frame.prices()[i], row);
+        }
+        benchmark::DoNotOptimize(row);
+    }
+    bench::setRowCounters(state, rows);
+}
+
+void BM_SignalModelPredict(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const std::string path = bench::syntheticModelFile();
+    SignalModel model;
+    SignalModel::load(path, model);
+    std::remove(path.c_str());
+    
+    const SignalFrame& frame = bench::syntheticFrame(rows);
+    std::vector<double> features(rows * IndicatorEngine::kFeatureCount);
+    IndicatorEngine::compute(frame.prices(), rows, features.data());
+    std::vector<int8_t> signals(rows);
+    for (auto _ : state) {
+        model.predict(features.data(), rows, IndicatorEngine::kFeatureCount, signals.data());
+        benchmark::ClobberMemory();
+    }
+    bench::setRowCounters(state, rows);
+}
+
+// Features, prediction and backtest in one native pipeline
+void BM_ModelBacktest(benchmark::State& state) {
+    const size_t rows = static_cast<size_t>(state.range(0));
+    const std::string path = bench::syntheticModelFile();
+    SignalModel model;
+    SignalModel::load(path, model);
+    std::remove(path.c_str());
+    
+    const SignalFrame& frame = bench::syntheticFrame(rows);
+    Backtester backtester(10000.0, 0.0005, 0.0);
+    for (auto _ : state) {
+        backtester.setSignals(model.generateSignals(frame.timestamps(), frame.prices(), rows));
+        backtester.runBacktest();
+        benchmark::DoNotOptimize(backtester.getResults());
+    }
+    bench::setRowCounters(state, rows);
+}
+
+// Rolling 10-"year" training and 1-"year" test windows over 1M bars
+void BM_WalkForward(benchmark::State& state) {
+    constexpr size_t kBars = 1000000;
+    const size_t candidates = static_cast<size_t>(state.range(0));
+    const SignalFrame& frame = bench::syntheticFrame(kBars);
+    
+    // Candidate c flips its signal with probability about 1 / (10 + c)
+    std::vector<int8_t> signals(candidates * kBars);
+    std::mt19937_64 rng(7);
+    for (size_t c = 0; c < candidates; ++c) {
+        int8_t signal = 0;
+        for (size_t i = 0; i < kBars; ++i) {
+            if (rng() % (10 + c) == 0) {
+                signal ^= 1;
+            }
+            signals[c * kBars + i] = signal;
+        }
+    }
+    
+    WalkForward walkForward(kBars, frame.timestamps(), frame.prices(), signals.data(), candidates, nullptr);
+    WalkForwardWindows windows;
+    windows.trainBars = 2520;
+    windows.testBars = 252;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(walkForward.run(windows, SweepConfig(), static_cast<size_t>(state.range(1))));
+    }
+    bench::setRowCounters(state, kBars * candidates);
+}
+
+} // namespace
+
+BENCHMARK(BM_LoadCSVMapped)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_CSV_ROWS)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadCSVStream)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_CSV_ROWS)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RunBacktest)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_ROWS)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RunBacktestFresh)->ArgsProduct({{1000, 100000, 10000000}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParameterSweep)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RunBacktestLatency)->ArgsProduct({benchmark::CreateRange(bench::kMinRows, BENCH_MAX_ROWS, 10), {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ExecutionEngine, NoSlippage, NoLatency, AllInSizing)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_ROWS)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ExecutionEngine, ProportionalSlippage, NoLatency, AllInSizing)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_ROWS)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ExecutionEngine, ProportionalSlippage, SearchLatency, AllInSizing)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_ROWS)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ExecutionEngine, ProportionalSlippage, SearchLatency, FixedNotionalSizing)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_ROWS)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SparseSignals)->ArgsProduct({{1000000, 10000000}, {1, 10, 100, 1000}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PortfolioBacktest)->ArgsProduct({{252, 2520}, {100, 3000}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SimulateTrades)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_ROWS)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CalculateAllMetrics)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_ROWS)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EquitySeriesPerPoint)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EquitySeries)->DenseRange(static_cast<int>(SimdLevel::Scalar), static_cast<int>(SimdLevel::AVX512))->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MaxDrawdownLoop)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MaxDrawdown)->DenseRange(static_cast<int>(SimdLevel::Scalar), static_cast<int>(SimdLevel::AVX512))->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Returns)->DenseRange(static_cast<int>(SimdLevel::Scalar), static_cast<int>(SimdLevel::AVX512))->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RollingMetricsNaive)->Arg(20)->Arg(60)->Arg(252)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RollingMetrics)->Arg(20)->Arg(60)->Arg(252)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ComputeIndicators)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_ROWS / 10)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IndicatorStateUpdate)->RangeMultiplier(100)->Range(bench::kMinRows, BENCH_MAX_ROWS / 10)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SignalModelPredict)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_ROWS / 100)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ModelBacktest)->RangeMultiplier(10)->Range(bench::kMinRows, BENCH_MAX_ROWS / 100)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WalkForward)->ArgsProduct({{1, 16, 64}, {1, 0}})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,221 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "signal_frame.h"
+#include "signal_model.h"
+#include "signal_panel.h"
+#include "timestamp.h"
+
+// Largest synthetic series (override with -DBENCH_MAX_ROWS=...)
+#ifndef BENCH_MAX_ROWS
+#define BENCH_MAX_ROWS 100000000
+#endif
+
+// CSV files are capped separately to bound disk usage
+#ifndef BENCH_MAX_CSV_ROWS
+#define BENCH_MAX_CSV_ROWS 10000000
+#endif
+
+namespace bench {
+
+constexpr int64_t kMinRows = 1000;
+constexpr int64_t kStartTime = 1672531200LL * 1000000000LL;  // 2023-01-01 00:00:00 UTC
+constexpr int64_t kBarNanos = 1000000000LL;                  // 1 second bars
+
+/**
+ * Synthetic random-walk prices with a signal that flips with the given
+ * probability per bar. Frames are generated once per size and cached.
+ */
+inline const SignalFrame& syntheticFrame(size_t rows, double flipProbability = 0.05) {
+    static std::map<std::pair<size_t, double>, SignalFrame> cache;
+    auto key = std::make_pair(rows, flipProbability);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> noise(0.0, 0.001);
+    std::bernoulli_distribution flip(flipProbability);
+    
+    std::vector<int64_t> timestamps(rows);
+    std::vector<double> prices(rows);
+    std::vector<int8_t> signals(rows);
+    
+    double price = 150.0;
+    int8_t signal = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        price *= 1.0 + noise(rng);
+        if (flip(rng)) {
+            signal = static_cast<int8_t>(1 - signal);
+        }
+        timestamps[i] = kStartTime + static_cast<int64_t>(i) * kBarNanos;
+        prices[i] = price;
+        signals[i] = signal;
+    }
+    
+    return cache.emplace(key, SignalFrame(std::move(timestamps), std::move(prices), std::move(signals))).first->second;
+}
+
+/**
+ * Synthetic (times x symbols) panel: one random walk per symbol, each with
+ * a signal that flips with the given probability per bar. Cached per shape.
+ */
+inline const SignalPanel& syntheticPanel(size_t times, size_t symbols, double flipProbability = 0.05) {
+    static std::map<std::pair<size_t, size_t>, SignalPanel> cache;
+    auto key = std::make_pair(times, symbols);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> noise(0.0, 0.001);
+    std::bernoulli_distribution flip(flipProbability);
+    
+    std::vector<std::string> names(symbols);
+    for (size_t s = 0; s < symbols; ++s) {
+        names[s] = "SYM" + std::to_string(s);
+    }
+    std::vector<int64_t> timestamps(times);
+    std::vector<double> prices(times * symbols);
+    std::vector<int8_t> signals(times * symbols);
+    std::vector<double> price(symbols, 150.0);
+    std::vector<int8_t> signal(symbols, 0);
+    for (size_t t = 0; t < times; ++t) {
+        timestamps[t] = kStartTime + static_cast<int64_t>(t) * kBarNanos;
+        for (size_t s = 0; s < symbols; ++s) {
+            price[s] *= 1.0 + noise(rng);
+            if (flip(rng)) {
+                signal[s] = static_cast<int8_t>(1 - signal[s]);
+            }
+            prices[t * symbols + s] = price[s];
+            signals[t * symbols + s] = signal[s];
+        }
+    }
+    
+    SignalPanel panel(std::move(names), std::move(timestamps), std::move(prices), std::move(signals));
+    return cache.emplace(key, panel).first->second;
+}
+
+/**
+ * Synthetic equity curve (geometric random walk) and its simple returns
+ */
+inline void syntheticEquity(size_t rows, std::vector<double>& equity, std::vector<double>& returns) {
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> noise(0.0005, 0.01);
+    
+    equity.resize(rows);
+    returns.resize(rows);
+    double value = 10000.0;
+    double last = value;
+    for (size_t i = 0; i < rows; ++i) {
+        value *= 1.0 + noise(rng);
+        equity[i] = value;
+        returns[i] = value / last - 1.0;
+        last = value;
+    }
+}
+
+/**
+ * Write a synthetic signals CSV (same layout as SignalGenerator.save_signals)
+ */
+inline std::string syntheticCSV(size_t rows) {
+    std::string path = "bench_signals_" + std::to_string(rows) + ".csv";
+    std::ifstream existing(path);
+    if (existing.good()) {
+        return path;
+    }
+    
+    const SignalFrame& frame = syntheticFrame(rows);
+    std::ofstream out(path);
+    out << "timestamp,price,signal\n";
+    char line[96];
+    for (size_t i = 0; i < rows; ++i) {
+        std::snprintf(line, sizeof(line), "%s,%.6f,%d\n",
+                      formatTimestamp(frame.timestamp(i)).c_str(), frame.price(i), frame.signal(i));
+        out << line;
+    }
+    return path;
+}
+
+/**
+ * Append a complete tree of the given depth in SignalModel's preorder layout
+ */
+inline void appendSyntheticTree(std::vector<ModelNode>& nodes, size_t depth, size_t features, std::mt19937_64& rng) {
+    if (depth == 0) {
+        nodes.push_back({-1, 0, std::uniform_real_distribution<double>(0.0, 1.0)(rng)});
+        return;
+    }
+    const size_t split = nodes.size();
+    nodes.push_back({static_cast<int32_t>(rng() % features), 0, std::normal_distribution<double>(0.0, 1.0)(rng)});
+    appendSyntheticTree(nodes, depth - 1, features, rng);
+    nodes[split].right = static_cast<int32_t>(nodes.size());
+    appendSyntheticTree(nodes, depth - 1, features, rng);
+}
+
+/**
+ * Write a synthetic random forest model file over the SignalGenerator
+ * feature columns (the default model: 100 trees of depth 5)
+ */
+inline std::string syntheticModelFile(size_t trees = 100, size_t depth = 5) {
+    std::string path = "bench_model_" + std::to_string(trees) + "x" + std::to_string(depth) + ".sqm";
+    
+    // Returns, MA5, MA10, MA20, RSI, Upper_Band, Lower_Band, MACD, Signal_Line
+    const std::vector<uint32_t> columns = {0, 1, 2, 3, 4, 6, 7, 10, 11};
+    const std::vector<double> mean = {0.0, 100.0, 100.0, 100.0, 50.0, 102.0, 98.0, 0.0, 0.0};
+    const std::vector<double> scale = {0.01, 10.0, 10.0, 10.0, 15.0, 10.0, 10.0, 0.5, 0.5};
+    
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> roots;
+    std::vector<ModelNode> nodes;
+    for (size_t t = 0; t < trees; ++t) {
+        roots.push_back(nodes.size());
+        appendSyntheticTree(nodes, depth, columns.size(), rng);
+    }
+    
+    ModelFileHeader header = {};
+    std::memcpy(header.magic, "SQMODEL", 8);
+    header.version = SignalModel::kVersion;
+    header.kind = kModelTreeEnsemble;
+    header.featureCount = static_cast<uint32_t>(columns.size());
+    header.treeCount = static_cast<uint32_t>(trees);
+    header.nodeCount = nodes.size();
+    header.classes[0] = 0;
+    header.classes[1] = 1;
+    
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(columns.data()), columns.size() * sizeof(uint32_t));
+    out.write(reinterpret_cast<const char*>(mean.data()), mean.size() * sizeof(double));
+    out.write(reinterpret_cast<const char*>(scale.data()), scale.size() * sizeof(double));
+    out.write(reinterpret_cast<const char*>(roots.data()), roots.size() * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(ModelNode));
+    return path;
+}
+
+/**
+ * Report throughput as rows/sec (items_per_second) and time per row
+ *
+ * time_per_row is printed with an SI prefix on the console (e.g. "12.4ns")
+ * and stored in seconds in JSON output.
+ */
+inline void setRowCounters(benchmark::State& state, size_t rows) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(rows));
+    state.counters["time_per_row"] = benchmark::Counter(
+        static_cast<double>(rows),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+} // namespace bench
+
+#endif // BENCH_COMMON_H
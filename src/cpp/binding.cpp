@@ -1,32 +1,123 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <string>
 #include <map>
+#include <optional>
 #include "backtester.h"
+#include "batch_backtest.h"
+#include "indicator_engine.h"
+#include "indicators.h"
+#include "parameter_sweep.h"
+#include "portfolio_backtester.h"
+#include "rolling_metrics.h"
+#include "signal_model.h"
+#include "thread_pool.h"
+#include "timestamp.h"
 #include "trade_simulator.h"
 #include "performance_metrics.h"
+#include "walk_forward.h"
 
 namespace py = pybind11;
 
+// Trade records go to NumPy as they are (side: 1 = BUY, 0 = SELL)
+PYBIND11_NUMPY_DTYPE(TradeRecord, timestamp, price, value, shares, side);
+
 /**
- * Run a backtest from Python
+ * Fixed-layout trade row for the structured NumPy portfolio trades array
+ */
+struct PortfolioTradeRow {
+    int64_t timestamp;  // Nanoseconds since the Unix epoch
+    int32_t symbol;     // Column of the symbol in the panel
+    Side side;          // 1 = BUY, 0 = SELL
+    int32_t shares;
+    double price;
+    double value;
+};
+
+PYBIND11_NUMPY_DTYPE(PortfolioTradeRow, timestamp, symbol, side, shares, price, value);
+
+/**
+ * Hand a vector to NumPy without copying its elements
+ * 
+ * The returned array owns the vector's buffer through a capsule, so a
+ * std::pmr::vector must use a resource that lives as long as the process
+ * (e.g. the default resource, as BacktestSeries guarantees).
+ * 
+ * @param values Vector to move into the array
+ * @return 1-D array over the vector's data
+ */
+template <typename T, typename Allocator>
+py::array_t<T> vector_to_array(std::vector<T, Allocator>&& values) {
+    using Vector = std::vector<T, Allocator>;
+    auto* owned = new Vector(std::move(values));
+    py::capsule owner(owned, [](void* p) { delete static_cast<Vector*>(p); });
+    return py::array_t<T>(static_cast<py::ssize_t>(owned->size()), owned->data(), owner);
+}
+
+/**
+ * Expose a SignalFrame column as a read-only array without copying
+ * 
+ * @param frame Frame owning the column (kept alive by the array)
+ * @param data Column data
+ * @param dtype NumPy dtype of the column
+ * @return 1-D read-only array over the column
+ */
+py::array frame_column_to_array(const SignalFrame& frame, const void* data, const py::dtype& dtype) {
+    auto* owned = new SignalFrame(frame);
+    py::capsule owner(owned, [](void* p) { delete static_cast<SignalFrame*>(p); });
+    py::array column(dtype, {static_cast<py::ssize_t>(frame.size())}, {dtype.itemsize()}, data, owner);
+    // Columns may live in a read-only file mapping
+    column.attr("setflags")(py::arg("write") = false);
+    return column;
+}
+
+/**
+ * Convert backtest output series to a dictionary of NumPy arrays
+ * 
+ * Equity, drawdowns, returns and the trade records are moved into the
+ * arrays; timestamps and prices are borrowed from the signal frame.
  * 
- * @param signalsFilePath Path to CSV file with signals
+ * @param series Output series (consumed)
+ * @return Dictionary of arrays
+ */
+py::dict series_to_dict(BacktestSeries&& series) {
+    py::dict seriesDict;
+    seriesDict["timestamps"] = frame_column_to_array(series.signals, series.signals.timestamps(), py::dtype::from_args(py::str("datetime64[ns]")));
+    seriesDict["prices"] = frame_column_to_array(series.signals, series.signals.prices(), py::dtype::of<double>());
+    seriesDict["equity"] = vector_to_array(std::move(series.equity));
+    seriesDict["drawdowns"] = vector_to_array(std::move(series.drawdowns));
+    seriesDict["returns"] = vector_to_array(std::move(series.returns));
+    seriesDict["trades"] = vector_to_array(std::move(series.trades));
+    return seriesDict;
+}
+
+/**
+ * Load signals and run a backtest without touching Python state
+ * 
+ * Safe to call with the GIL released.
+ * 
+ * @param signalsFilePath Path to a CSV or binary signal file
  * @param initialCapital Initial capital for the backtest
  * @param slippage Slippage parameter
  * @param latency Latency parameter in seconds
- * @return Dictionary with backtest results
+ * @param series Optional output for the per-row series
+ * @return Backtest results
  */
-py::dict run_backtest(const std::string& signalsFilePath, 
-                     double initialCapital = 10000.0, 
-                     double slippage = 0.0005, 
-                     double latency = 0.0) {
+BacktestResults run_backtest_native(const std::string& signalsFilePath,
+                                    double initialCapital,
+                                    double slippage,
+                                    double latency,
+                                    BacktestSeries* series = nullptr) {
     // Create backtester
     Backtester backtester(initialCapital, slippage, latency);
     
-    // Load signals
-    if (!backtester.loadSignalsFromCSV(signalsFilePath)) {
-        throw std::runtime_error("Failed to load signals from CSV file");
+    // Load signals (binary signal files are detected by their magic bytes)
+    if (!backtester.loadSignalsFromFile(signalsFilePath)) {
+        throw std::runtime_error("Failed to load signals from " + signalsFilePath);
     }
     
     // Run backtest
@@ -34,18 +125,819 @@ py::dict run_backtest(const std::string& signalsFilePath,
     
     // Get results
     BacktestResults results = backtester.getResults();
-    
-    // Create Python dictionary with results
+    if (series != nullptr) {
+        *series = backtester.releaseSeries();
+    }
+    return results;
+}
+
+/**
+ * Convert backtest results to a Python dictionary
+ * 
+ * @param results Backtest results
+ * @return Dictionary with backtest results
+ */
+py::dict results_to_dict(const BacktestResults& results) {
     py::dict resultsDict;
     resultsDict["final_equity"] = results.finalEquity;
     resultsDict["final_return"] = results.finalReturn;
     resultsDict["max_drawdown"] = results.maxDrawdown;
     resultsDict["sharpe_ratio"] = results.sharpeRatio;
     resultsDict["total_trades"] = results.totalTrades;
+    return resultsDict;
+}
+
+/**
+ * Run a backtest from Python
+ * 
+ * The GIL is released while signals are loaded and simulated.
+ * 
+ * @param signalsFilePath Path to a CSV or binary signal file
+ * @param initialCapital Initial capital for the backtest
+ * @param slippage Slippage parameter
+ * @param latency Latency parameter in seconds
+ * @param includeSeries Also return the per-row series as NumPy arrays
+ * @return Dictionary with backtest results
+ */
+py::dict run_backtest(const std::string& signalsFilePath, 
+                     double initialCapital = 10000.0, 
+                     double slippage = 0.0005, 
+                     double latency = 0.0,
+                     bool includeSeries = false) {
+    BacktestResults results;
+    BacktestSeries series;
+    {
+        py::gil_scoped_release release;
+        results = run_backtest_native(signalsFilePath, initialCapital, slippage, latency,
+                                      includeSeries ? &series : nullptr);
+    }
+    
+    py::dict resultsDict = results_to_dict(results);
+    if (includeSeries) {
+        resultsDict["series"] = series_to_dict(std::move(series));
+    }
+    return resultsDict;
+}
+
+using TimestampArray = py::array_t<int64_t, py::array::c_style | py::array::forcecast>;
+using PriceArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+using SignalArray = py::array_t<int8_t, py::array::c_style | py::array::forcecast>;
+
+/**
+ * References to the NumPy columns behind a borrowed frame, panel or store
+ */
+struct ArrayOwner {
+    TimestampArray timestamps;
+    PriceArray prices;
+    SignalArray signals;
+};
+
+/**
+ * Keep NumPy columns alive for as long as the engine borrows them
+ * 
+ * @param timestamps Timestamps array
+ * @param prices Prices array
+ * @param signals Signals array
+ * @return Owner releasing the arrays under the GIL, since the engine may
+ *         drop its last reference on a worker thread without it
+ */
+std::shared_ptr<ArrayOwner> make_array_owner(const TimestampArray& timestamps,
+                                             const PriceArray& prices,
+                                             const SignalArray& signals) {
+    return std::shared_ptr<ArrayOwner>(new ArrayOwner{timestamps, prices, signals}, [](ArrayOwner* arrays) {
+        py::gil_scoped_acquire acquire;
+        delete arrays;
+    });
+}
+
+/**
+ * Wrap NumPy columns in a SignalFrame without copying
+ * 
+ * Arrays that are already C-contiguous with the matching dtype (int64,
+ * float64, int8) are used in place; anything else is converted once by
+ * NumPy. The frame holds references to the arrays, released under the GIL.
+ * 
+ * @param timestamps Timestamps as int64 nanoseconds since the epoch
+ * @param prices Prices
+ * @param signals Signals (0 or 1)
+ * @return SignalFrame borrowing the array buffers
+ */
+SignalFrame frame_from_arrays(const TimestampArray& timestamps, const PriceArray& prices, const SignalArray& signals) {
+    if (timestamps.ndim() != 1 || prices.ndim() != 1 || signals.ndim() != 1) {
+        throw py::value_error("timestamps, prices and signals must be 1-D arrays");
+    }
+    if (timestamps.shape(0) != prices.shape(0) || prices.shape(0) != signals.shape(0)) {
+        throw py::value_error("timestamps, prices and signals must have the same length");
+    }
+    
+    std::shared_ptr<ArrayOwner> owner = make_array_owner(timestamps, prices, signals);
+    
+    return SignalFrame(static_cast<size_t>(prices.shape(0)),
+                       owner->timestamps.data(),
+                       owner->prices.data(),
+                       owner->signals.data(),
+                       owner);
+}
+
+/**
+ * Run a backtest on in-memory NumPy columns
+ * 
+ * @param timestamps Timestamps as int64 nanoseconds since the epoch
+ * @param prices Prices
+ * @param signals Signals (0 or 1)
+ * @param initialCapital Initial capital for the backtest
+ * @param slippage Slippage parameter
+ * @param latency Latency parameter in seconds
+ * @param includeSeries Also return the per-row series as NumPy arrays
+ * @return Dictionary with backtest results
+ */
+py::dict run_backtest_arrays(const TimestampArray& timestamps,
+                             const PriceArray& prices,
+                             const SignalArray& signals,
+                             double initialCapital = 10000.0,
+                             double slippage = 0.0005,
+                             double latency = 0.0,
+                             bool includeSeries = false) {
+    Backtester backtester(initialCapital, slippage, latency);
+    backtester.setSignals(frame_from_arrays(timestamps, prices, signals));
+    
+    BacktestResults results;
+    {
+        py::gil_scoped_release release;
+        backtester.runBacktest();
+        results = backtester.getResults();
+    }
+    
+    py::dict resultsDict = results_to_dict(results);
+    if (includeSeries) {
+        resultsDict["series"] = series_to_dict(backtester.releaseSeries());
+    }
+    return resultsDict;
+}
+
+/**
+ * Wrap a (times x symbols) NumPy panel in a SignalPanel without copying
+ * 
+ * C-ordered price and signal arrays of shape (times, symbols) already have
+ * the panel's layout and are used in place when their dtypes match.
+ * 
+ * @param symbols Symbol names, one per column
+ * @param timestamps Timestamps as int64 nanoseconds since the epoch
+ * @param prices Prices, shape (times, symbols)
+ * @param signals Signals (0 or 1), shape (times, symbols)
+ * @return SignalPanel borrowing the array buffers
+ */
+SignalPanel panel_from_arrays(const std::vector<std::string>& symbols,
+                              const TimestampArray& timestamps,
+                              const PriceArray& prices,
+                              const SignalArray& signals) {
+    if (timestamps.ndim() != 1 || prices.ndim() != 2 || signals.ndim() != 2) {
+        throw py::value_error("timestamps must be 1-D and prices and signals 2-D (times, symbols)");
+    }
+    if (prices.shape(0) != timestamps.shape(0) || signals.shape(0) != timestamps.shape(0) ||
+        prices.shape(1) != static_cast<py::ssize_t>(symbols.size()) ||
+        signals.shape(1) != static_cast<py::ssize_t>(symbols.size())) {
+        throw py::value_error("prices and signals must have shape (len(timestamps), len(symbols))");
+    }
+    
+    std::shared_ptr<ArrayOwner> owner = make_array_owner(timestamps, prices, signals);
+    
+    return SignalPanel(symbols,
+                       static_cast<size_t>(timestamps.shape(0)),
+                       owner->timestamps.data(),
+                       owner->prices.data(),
+                       owner->signals.data(),
+                       owner);
+}
+
+/**
+ * Run a portfolio backtest on a (times x symbols) NumPy panel
+ * 
+ * @param timestamps Timestamps as int64 nanoseconds since the epoch
+ * @param prices Prices, shape (times, symbols)
+ * @param signals Signals (0 or 1), shape (times, symbols)
+ * @param symbols Symbol names, one per column
+ * @param initialCapital Initial capital for the whole portfolio
+ * @param slippage Slippage parameter
+ * @param latency Latency parameter in seconds
+ * @param weights Capital weight per symbol (None = equal weights)
+ * @param includeSeries Also return the per-timestamp series as NumPy arrays
+ * @return Dictionary with aggregate backtest results
+ */
+py::dict run_portfolio_backtest(const TimestampArray& timestamps,
+                                const PriceArray& prices,
+                                const SignalArray& signals,
+                                const std::vector<std::string>& symbols,
+                                double initialCapital = 10000.0,
+                                double slippage = 0.0005,
+                                double latency = 0.0,
+                                const std::optional<std::vector<double>>& weights = std::nullopt,
+                                bool includeSeries = false) {
+    PortfolioBacktester backtester(initialCapital, slippage, latency);
+    backtester.setPanel(panel_from_arrays(symbols, timestamps, prices, signals));
+    if (weights) {
+        backtester.setWeights(*weights);
+    }
+    
+    BacktestResults results;
+    {
+        py::gil_scoped_release release;
+        backtester.runBacktest();
+        results = backtester.getResults();
+    }
+    
+    py::dict resultsDict = results_to_dict(results);
+    if (includeSeries) {
+        PortfolioSeries series = backtester.releaseSeries();
+        
+        std::vector<PortfolioTradeRow> trades;
+        trades.reserve(series.trades.size());
+        for (const auto& trade : series.trades) {
+            trades.push_back({trade.fill.timestamp,
+                              static_cast<int32_t>(trade.symbol),
+                              trade.fill.side,
+                              trade.fill.shares,
+                              trade.fill.price,
+                              trade.fill.value});
+        }
+        
+        py::dict seriesDict;
+        seriesDict["equity"] = vector_to_array(std::move(series.equity));
+        seriesDict["drawdowns"] = vector_to_array(std::move(series.drawdowns));
+        seriesDict["returns"] = vector_to_array(std::move(series.returns));
+        seriesDict["symbol_equity"] = vector_to_array(std::move(series.symbolEquity));
+        seriesDict["trades"] = vector_to_array(std::move(trades));
+        resultsDict["series"] = seriesDict;
+    }
+    return resultsDict;
+}
+
+/**
+ * Thread pool shared by asynchronous backtests
+ */
+ThreadPool& async_pool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+/**
+ * Handle to a backtest running on the async pool
+ */
+class BacktestFuture {
+public:
+    explicit BacktestFuture(std::shared_future<BacktestResults> future)
+        : m_future(std::move(future)) {}
+    
+    /**
+     * Check whether the backtest has finished
+     * 
+     * @return True if a result (or error) is available
+     */
+    bool done() const {
+        return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    
+    /**
+     * Wait for the backtest to finish
+     * 
+     * @param timeout Maximum time to wait in seconds (None = no limit)
+     * @return True if the backtest finished
+     */
+    bool wait(std::optional<double> timeout) const {
+        // The timeout is converted by pybind11 while the GIL is still held
+        py::gil_scoped_release release;
+        if (!timeout) {
+            m_future.wait();
+            return true;
+        }
+        return m_future.wait_for(std::chrono::duration<double>(*timeout)) == std::future_status::ready;
+    }
+    
+    /**
+     * Get the backtest results, waiting if necessary
+     * 
+     * @param timeout Maximum time to wait in seconds (None = no limit)
+     * @return Dictionary with backtest results
+     */
+    py::dict result(std::optional<double> timeout) const {
+        if (!wait(timeout)) {
+            PyErr_SetString(PyExc_TimeoutError, "Backtest did not finish within the timeout");
+            throw py::error_already_set();
+        }
+        
+        // Rethrows the backtest's exception, if any
+        return results_to_dict(m_future.get());
+    }
+    
+private:
+    std::shared_future<BacktestResults> m_future;
+};
+
+/**
+ * Start a backtest on a background thread
+ * 
+ * @param signalsFilePath Path to a CSV or binary signal file
+ * @param initialCapital Initial capital for the backtest
+ * @param slippage Slippage parameter
+ * @param latency Latency parameter in seconds
+ * @return Handle for the running backtest
+ */
+BacktestFuture run_backtest_async(const std::string& signalsFilePath,
+                                  double initialCapital = 10000.0,
+                                  double slippage = 0.0005,
+                                  double latency = 0.0) {
+    std::future<BacktestResults> future = async_pool().submit([=] {
+        return run_backtest_native(signalsFilePath, initialCapital, slippage, latency);
+    });
+    return BacktestFuture(future.share());
+}
+
+/**
+ * Run a grid of backtest configurations over one signals file
+ * 
+ * The signals are loaded once and every (capital, slippage, latency)
+ * combination runs on the thread pool with the GIL released.
+ * 
+ * @param signalsFilePath Path to a CSV or binary signal file
+ * @param initialCapitals Initial capital values
+ * @param slippages Slippage values
+ * @param latencies Latency values in seconds
+ * @param numThreads Number of worker threads (0 = one per hardware thread)
+ * @return Dictionary of equal-length NumPy columns, one row per configuration
+ */
+py::dict run_parameter_sweep(const std::string& signalsFilePath,
+                             const std::vector<double>& initialCapitals,
+                             const std::vector<double>& slippages,
+                             const std::vector<double>& latencies,
+                             size_t numThreads = 0) {
+    std::vector<SweepConfig> configs;
+    std::vector<BacktestResults> results;
+    bool loaded = false;
+    {
+        py::gil_scoped_release release;
+        
+        Backtester loader;
+        loaded = loader.loadSignalsFromFile(signalsFilePath);
+        if (loaded) {
+            ParameterSweep sweep(loader.getSignals());
+            configs = ParameterSweep::makeGrid(initialCapitals, slippages, latencies);
+            results = sweep.run(configs, numThreads);
+        }
+    }
+    if (!loaded) {
+        throw std::runtime_error("Failed to load signals from " + signalsFilePath);
+    }
+    
+    const py::ssize_t rows = static_cast<py::ssize_t>(configs.size());
+    py::array_t<double> initialCapital(rows), slippage(rows), latency(rows);
+    py::array_t<double> finalEquity(rows), finalReturn(rows), maxDrawdown(rows), sharpeRatio(rows);
+    py::array_t<int> totalTrades(rows);
     
+    auto initialCapitalOut = initialCapital.mutable_unchecked<1>();
+    auto slippageOut = slippage.mutable_unchecked<1>();
+    auto latencyOut = latency.mutable_unchecked<1>();
+    auto finalEquityOut = finalEquity.mutable_unchecked<1>();
+    auto finalReturnOut = finalReturn.mutable_unchecked<1>();
+    auto maxDrawdownOut = maxDrawdown.mutable_unchecked<1>();
+    auto sharpeRatioOut = sharpeRatio.mutable_unchecked<1>();
+    auto totalTradesOut = totalTrades.mutable_unchecked<1>();
+    for (py::ssize_t i = 0; i < rows; ++i) {
+        initialCapitalOut(i) = configs[i].initialCapital;
+        slippageOut(i) = configs[i].slippage;
+        latencyOut(i) = configs[i].latency;
+        finalEquityOut(i) = results[i].finalEquity;
+        finalReturnOut(i) = results[i].finalReturn;
+        maxDrawdownOut(i) = results[i].maxDrawdown;
+        sharpeRatioOut(i) = results[i].sharpeRatio;
+        totalTradesOut(i) = results[i].totalTrades;
+    }
+    
+    py::dict table;
+    table["initial_capital"] = initialCapital;
+    table["slippage"] = slippage;
+    table["latency"] = latency;
+    table["final_equity"] = finalEquity;
+    table["final_return"] = finalReturn;
+    table["max_drawdown"] = maxDrawdown;
+    table["sharpe_ratio"] = sharpeRatio;
+    table["total_trades"] = totalTrades;
+    return table;
+}
+
+/**
+ * Run independent single-symbol backtests in parallel
+ * 
+ * Every source is loaded and simulated on the thread pool with the GIL
+ * released; arrays are borrowed without copying.
+ * 
+ * @param sources Signal file paths or (timestamps, prices, signals) array tuples
+ * @param initialCapital Initial capital for each backtest
+ * @param slippage Slippage parameter
+ * @param latency Latency parameter in seconds
+ * @param numThreads Number of worker threads (0 = one per hardware thread)
+ * @return Dictionary of equal-length NumPy columns, one row per source
+ */
+py::dict run_backtests(const py::list& sources,
+                       double initialCapital = 10000.0,
+                       double slippage = 0.0005,
+                       double latency = 0.0,
+                       size_t numThreads = 0) {
+    std::vector<BatchJob> jobs;
+    jobs.reserve(sources.size());
+    for (const py::handle& source : sources) {
+        BatchJob job;
+        if (py::isinstance<py::str>(source)) {
+            job.path = source.cast<std::string>();
+        } else {
+            if (!py::isinstance<py::sequence>(source) || py::len(source) != 3) {
+                throw py::type_error("Each source must be a path or a (timestamps, prices, signals) tuple");
+            }
+            py::sequence arrays = py::reinterpret_borrow<py::sequence>(source);
+            job.signals = frame_from_arrays(arrays[0].cast<TimestampArray>(),
+                                            arrays[1].cast<PriceArray>(),
+                                            arrays[2].cast<SignalArray>());
+        }
+        jobs.push_back(std::move(job));
+    }
+    
+    std::vector<BatchResult> results;
+    {
+        py::gil_scoped_release release;
+        BatchBacktest batch({initialCapital, slippage, latency});
+        results = batch.run(jobs, numThreads);
+    }
+    
+    const py::ssize_t rows = static_cast<py::ssize_t>(results.size());
+    py::array_t<bool> loaded(rows);
+    py::array_t<int64_t> signalRows(rows);
+    py::array_t<double> finalEquity(rows), finalReturn(rows), maxDrawdown(rows), sharpeRatio(rows);
+    py::array_t<int> totalTrades(rows);
+    
+    auto loadedOut = loaded.mutable_unchecked<1>();
+    auto signalRowsOut = signalRows.mutable_unchecked<1>();
+    auto finalEquityOut = finalEquity.mutable_unchecked<1>();
+    auto finalReturnOut = finalReturn.mutable_unchecked<1>();
+    auto maxDrawdownOut = maxDrawdown.mutable_unchecked<1>();
+    auto sharpeRatioOut = sharpeRatio.mutable_unchecked<1>();
+    auto totalTradesOut = totalTrades.mutable_unchecked<1>();
+    for (py::ssize_t i = 0; i < rows; ++i) {
+        loadedOut(i) = results[i].loaded;
+        signalRowsOut(i) = static_cast<int64_t>(results[i].rows);
+        finalEquityOut(i) = results[i].results.finalEquity;
+        finalReturnOut(i) = results[i].results.finalReturn;
+        maxDrawdownOut(i) = results[i].results.maxDrawdown;
+        sharpeRatioOut(i) = results[i].results.sharpeRatio;
+        totalTradesOut(i) = results[i].results.totalTrades;
+    }
+    
+    py::dict table;
+    table["loaded"] = loaded;
+    table["rows"] = signalRows;
+    table["final_equity"] = finalEquity;
+    table["final_return"] = finalReturn;
+    table["max_drawdown"] = maxDrawdown;
+    table["sharpe_ratio"] = sharpeRatio;
+    table["total_trades"] = totalTrades;
+    return table;
+}
+
+/**
+ * Compute the technical indicator features of close price series
+ * 
+ * A 2-D close array holds one series per row; rows are processed in
+ * parallel with the GIL released. Features are written straight into
+ * `out` when given: a writeable float64 array of shape close.shape +
+ * (feature count,) whose feature axis is contiguous, such as a column
+ * slice of a wider feature matrix.
+ * 
+ * @param close Close prices (1-D) or one series per row (2-D)
+ * @param out Optional preallocated feature array
+ * @param numThreads Number of worker threads (0 = one per hardware thread)
+ * @return The feature array
+ */
+py::array compute_indicators(const PriceArray& close, py::object out, size_t numThreads = 0) {
+    if (close.ndim() != 1 && close.ndim() != 2) {
+        throw py::value_error("close must be a 1-D or 2-D array");
+    }
+    
+    std::vector<py::ssize_t> shape(close.shape(), close.shape() + close.ndim());
+    shape.push_back(static_cast<py::ssize_t>(IndicatorEngine::kFeatureCount));
+    
+    py::array features;
+    if (out.is_none()) {
+        features = py::array_t<double>(shape);
+    } else {
+        if (!py::isinstance<py::array_t<double>>(out)) {
+            throw py::type_error("out must be a float64 NumPy array");
+        }
+        features = py::reinterpret_borrow<py::array>(out);
+        if (!features.writeable()) {
+            throw py::value_error("out must be writeable");
+        }
+        if (features.ndim() != close.ndim() + 1 ||
+            !std::equal(shape.begin(), shape.end(), features.shape())) {
+            throw py::value_error("out must have shape close.shape + (" +
+                                  std::to_string(IndicatorEngine::kFeatureCount) + ",)");
+        }
+        for (py::ssize_t axis = 0; axis < features.ndim(); ++axis) {
+            if (features.strides(axis) < 0 || features.strides(axis) % static_cast<py::ssize_t>(sizeof(double)) != 0) {
+                throw py::value_error("out strides must be non-negative multiples of 8 bytes");
+            }
+        }
+        if (features.strides(features.ndim() - 1) != static_cast<py::ssize_t>(sizeof(double))) {
+            throw py::value_error("out must be contiguous along the feature axis");
+        }
+    }
+    
+    const size_t series = close.ndim() == 2 ? static_cast<size_t>(close.shape(0)) : 1;
+    const size_t bars = static_cast<size_t>(close.shape(close.ndim() - 1));
+    const size_t rowStride = static_cast<size_t>(features.strides(features.ndim() - 2)) / sizeof(double);
+    const size_t seriesStride = close.ndim() == 2 ? static_cast<size_t>(features.strides(0)) / sizeof(double) : 0;
+    if ((bars > 1 && rowStride < IndicatorEngine::kFeatureCount) ||
+        (series > 1 && seriesStride < bars * rowStride)) {
+        throw py::value_error("out rows must not overlap");
+    }
+    const double* input = close.data();
+    double* output = static_cast<double*>(features.mutable_data());
+    {
+        py::gil_scoped_release release;
+        
+        auto body = [&](size_t s) {
+            IndicatorEngine::compute(input + s * bars, bars, output + s * seriesStride, rowStride);
+        };
+        if (series > 1) {
+            ThreadPool pool(std::min(numThreads == 0 ? std::thread::hardware_concurrency() : numThreads, series));
+            pool.parallelFor(series, body);
+        } else if (series == 1) {
+            body(0);
+        }
+    }
+    return features;
+}
+
+/**
+ * Compute rolling Sharpe, Sortino, volatility and drawdown for every bar
+ * 
+ * A 2-D equity array holds one run per row; rows are processed in
+ * parallel with the GIL released. Every output array has the shape of the
+ * input and is written in place, so nothing is copied on the way back.
+ * 
+ * @param equity Equity curve (1-D) or curves (2-D, runs x bars)
+ * @param windows Window lengths in bars
+ * @param riskFreeRate Annual risk-free rate (e.g., 0.02 for 2%)
+ * @param numThreads Number of worker threads (0 = one per hardware thread)
+ * @return Dictionary mapping each window to a dict of NumPy arrays
+ */
+py::dict rolling_metrics(const PriceArray& equity,
+                         const std::vector<size_t>& windows,
+                         double riskFreeRate = 0.0,
+                         size_t numThreads = 0) {
+    if (equity.ndim() != 1 && equity.ndim() != 2) {
+        throw py::value_error("equity must be a 1-D or 2-D array");
+    }
+    for (size_t window : windows) {
+        if (window == 0) {
+            throw py::value_error("Rolling windows must be positive");
+        }
+    }
+    
+    const size_t runs = equity.ndim() == 2 ? static_cast<size_t>(equity.shape(0)) : 1;
+    const size_t bars = static_cast<size_t>(equity.shape(equity.ndim() - 1));
+    std::vector<py::ssize_t> shape(equity.shape(), equity.shape() + equity.ndim());
+    
+    struct WindowArrays {
+        py::array_t<double> volatility, sharpe, sortino, drawdown;
+    };
+    std::vector<WindowArrays> arrays;
+    std::vector<RollingOutputs> outputs;
+    arrays.reserve(windows.size());
+    outputs.reserve(windows.size());
+    for (size_t w = 0; w < windows.size(); ++w) {
+        arrays.push_back({py::array_t<double>(shape), py::array_t<double>(shape),
+                          py::array_t<double>(shape), py::array_t<double>(shape)});
+        outputs.push_back({arrays[w].volatility.mutable_data(), arrays[w].sharpe.mutable_data(),
+                           arrays[w].sortino.mutable_data(), arrays[w].drawdown.mutable_data()});
+    }
+    
+    const double* input = equity.data();
+    {
+        py::gil_scoped_release release;
+        
+        // One task per (run, window) pair, each writing its own rows
+        auto body = [&](size_t task) {
+            const size_t run = task / windows.size();
+            const size_t w = task % windows.size();
+            const size_t offset = run * bars;
+            RollingMetrics metrics(windows[w], riskFreeRate);
+            metrics.compute(input + offset, bars, {outputs[w].volatility + offset, outputs[w].sharpe + offset,
+                                                   outputs[w].sortino + offset, outputs[w].drawdown + offset});
+        };
+        
+        const size_t tasks = runs * windows.size();
+        if (tasks > 1) {
+            ThreadPool pool(std::min(numThreads == 0 ? std::thread::hardware_concurrency() : numThreads, tasks));
+            pool.parallelFor(tasks, body);
+        } else if (tasks == 1) {
+            body(0);
+        }
+    }
+    
+    py::dict result;
+    for (size_t w = 0; w < windows.size(); ++w) {
+        py::dict columns;
+        columns["volatility"] = arrays[w].volatility;
+        columns["sharpe_ratio"] = arrays[w].sharpe;
+        columns["sortino_ratio"] = arrays[w].sortino;
+        columns["drawdown"] = arrays[w].drawdown;
+        result[py::int_(windows[w])] = columns;
+    }
+    return result;
+}
+
+/**
+ * Run a walk-forward analysis over candidate signal series
+ * 
+ * The columns are shared read-only by the parallel folds without copying
+ * when they already have the engine's dtypes and are C-contiguous.
+ * 
+ * @param timestamps Timestamps as int64 nanoseconds since the epoch
+ * @param prices Prices
+ * @param signals Signals (0 or 1), one row per candidate: shape (candidates, bars) or (bars,)
+ * @param trainBars Bars in each training window
+ * @param testBars Bars in each out-of-sample window
+ * @param anchored Grow the training window from the first bar
+ * @param initialCapital Initial capital for the backtests
+ * @param slippage Slippage parameter
+ * @param latency Latency parameter in seconds
+ * @param numThreads Number of worker threads (0 = one per hardware thread)
+ * @return Dictionary with the stitched results and the per-fold results
+ */
+py::dict walk_forward(const TimestampArray& timestamps,
+                      const PriceArray& prices,
+                      const SignalArray& signals,
+                      size_t trainBars = 252,
+                      size_t testBars = 63,
+                      bool anchored = false,
+                      double initialCapital = 10000.0,
+                      double slippage = 0.0005,
+                      double latency = 0.0,
+                      size_t numThreads = 0) {
+    if (timestamps.ndim() != 1 || prices.ndim() != 1 || (signals.ndim() != 1 && signals.ndim() != 2)) {
+        throw py::value_error("timestamps and prices must be 1-D and signals 1-D or 2-D (candidates, bars)");
+    }
+    if (prices.shape(0) != timestamps.shape(0) || signals.shape(signals.ndim() - 1) != timestamps.shape(0)) {
+        throw py::value_error("prices and every signal row must have len(timestamps) values");
+    }
+    
+    std::shared_ptr<ArrayOwner> owner = make_array_owner(timestamps, prices, signals);
+    
+    const size_t candidates = signals.ndim() == 2 ? static_cast<size_t>(signals.shape(0)) : 1;
+    WalkForward walkForward(static_cast<size_t>(timestamps.shape(0)),
+                            owner->timestamps.data(),
+                            owner->prices.data(),
+                            owner->signals.data(),
+                            candidates,
+                            owner);
+    
+    WalkForwardWindows windows;
+    windows.trainBars = trainBars;
+    windows.testBars = testBars;
+    windows.anchored = anchored;
+    SweepConfig config{initialCapital, slippage, latency};
+    
+    WalkForwardResults results;
+    {
+        py::gil_scoped_release release;
+        results = walkForward.run(windows, config, numThreads);
+    }
+    
+    py::list folds;
+    for (WalkForwardFold& fold : results.folds) {
+        py::dict foldDict = results_to_dict(fold.results);
+        foldDict["train_begin"] = fold.trainBegin;
+        foldDict["train_end"] = fold.trainEnd;
+        foldDict["test_begin"] = fold.testBegin;
+        foldDict["test_end"] = fold.testEnd;
+        foldDict["candidate"] = fold.candidate;
+        foldDict["train_sharpe"] = fold.trainSharpe;
+        foldDict["equity"] = vector_to_array(std::move(fold.equity));
+        folds.append(foldDict);
+    }
+    
+    py::dict resultsDict = results_to_dict(results.results);
+    resultsDict["timestamps"] = vector_to_array(std::move(results.timestamps));
+    resultsDict["equity"] = vector_to_array(std::move(results.equity));
+    resultsDict["folds"] = folds;
     return resultsDict;
 }
 
+/**
+ * Load an exported signal model, raising ValueError if the file is unusable
+ * 
+ * @param modelPath Path to a model file written by SignalGenerator.export_model()
+ * @return The model
+ */
+SignalModel load_signal_model(const std::string& modelPath) {
+    SignalModel model;
+    if (!SignalModel::load(modelPath, model)) {
+        throw py::value_error("Could not load model file " + modelPath);
+    }
+    return model;
+}
+
+/**
+ * Predict a signal for each row of a feature matrix
+ * 
+ * @param model Signal model
+ * @param features Feature matrix, shape (rows, columns); the model picks its inputs by column
+ * @return int8 signal per row
+ */
+py::array_t<int8_t> predict_signals(const SignalModel& model, const PriceArray& features) {
+    if (features.ndim() != 2) {
+        throw py::value_error("features must be a 2-D array (rows, columns)");
+    }
+    if (static_cast<size_t>(features.shape(1)) < model.requiredColumns()) {
+        throw py::value_error("features must have at least " + std::to_string(model.requiredColumns()) + " columns");
+    }
+    
+    const size_t rows = static_cast<size_t>(features.shape(0));
+    const size_t columns = static_cast<size_t>(features.shape(1));
+    py::array_t<int8_t> signals(static_cast<py::ssize_t>(rows));
+    const double* input = features.data();
+    int8_t* output = signals.mutable_data();
+    {
+        py::gil_scoped_release release;
+        model.predict(input, rows, columns, output);
+    }
+    return signals;
+}
+
+/**
+ * Compute indicator features, predict signals and backtest them natively
+ * 
+ * Rows whose indicators are still warming up are dropped, as in
+ * SignalGenerator.generate_signals, so the run matches the Python pipeline
+ * without any Python in the loop.
+ * 
+ * @param timestamps Timestamps as int64 nanoseconds since the epoch
+ * @param close Close prices
+ * @param model Signal model reading IndicatorEngine feature columns
+ * @param initialCapital Initial capital for the backtest
+ * @param slippage Slippage parameter
+ * @param latency Latency parameter in seconds
+ * @param includeSeries Also return the per-row series as NumPy arrays
+ * @return Dictionary with backtest results
+ */
+py::dict run_model_backtest(const TimestampArray& timestamps,
+                            const PriceArray& close,
+                            const SignalModel& model,
+                            double initialCapital = 10000.0,
+                            double slippage = 0.0005,
+                            double latency = 0.0,
+                            bool includeSeries = false) {
+    if (timestamps.ndim() != 1 || close.ndim() != 1 || timestamps.shape(0) != close.shape(0)) {
+        throw py::value_error("timestamps and close must be 1-D arrays of the same length");
+    }
+    if (model.requiredColumns() > IndicatorEngine::kFeatureCount) {
+        throw py::value_error("Model reads columns beyond INDICATOR_COLUMNS");
+    }
+    
+    Backtester backtester(initialCapital, slippage, latency);
+    BacktestResults results;
+    {
+        py::gil_scoped_release release;
+        backtester.setSignals(model.generateSignals(timestamps.data(), close.data(),
+                                                    static_cast<size_t>(close.shape(0))));
+        backtester.runBacktest();
+        results = backtester.getResults();
+    }
+    
+    py::dict resultsDict = results_to_dict(results);
+    if (includeSeries) {
+        resultsDict["series"] = series_to_dict(backtester.releaseSeries());
+    }
+    return resultsDict;
+}
+
+/**
+ * Add checkpoint support (to_bytes, from_bytes and pickling) to an indicator class
+ * 
+ * @param cls Bound indicator class
+ */
+template <typename Indicator>
+void def_indicator_state(py::class_<Indicator>& cls) {
+    cls.def("to_bytes",
+            [](const Indicator& self) { return py::bytes(saveIndicatorState(self)); },
+            "Serialize the state as bytes")
+       .def_static("from_bytes",
+                   [](const py::bytes& data) { return loadIndicatorState<Indicator>(data); },
+                   py::arg("data"),
+                   "Restore an indicator from to_bytes() output")
+       .def(py::pickle(
+           [](const Indicator& self) { return py::bytes(saveIndicatorState(self)); },
+           [](const py::bytes& data) { return loadIndicatorState<Indicator>(data); }));
+}
+
 PYBIND11_MODULE(quant_cpp_engine, m) {
     m.doc() = "C++ backtesting engine for quant trading platform";
     
@@ -55,7 +947,212 @@ PYBIND11_MODULE(quant_cpp_engine, m) {
           py::arg("initial_capital") = 10000.0,
           py::arg("slippage") = 0.0005,
           py::arg("latency") = 0.0,
-          "Run a backtest with the given signals and parameters");
+          py::arg("include_series") = false,
+          "Run a backtest with the given signals and parameters. With include_series=True "
+          "the result also holds a 'series' dict of NumPy arrays (timestamps, prices, equity, "
+          "drawdowns, returns and a structured trades array)");
+    
+    m.def("run_backtest_arrays", &run_backtest_arrays,
+          py::arg("timestamps"),
+          py::arg("prices"),
+          py::arg("signals"),
+          py::arg("initial_capital") = 10000.0,
+          py::arg("slippage") = 0.0005,
+          py::arg("latency") = 0.0,
+          py::arg("include_series") = false,
+          "Run a backtest on NumPy arrays (int64 epoch-ns timestamps, float64 prices, "
+          "int8 signals) without writing a signals file");
+    
+    m.def("run_portfolio_backtest", &run_portfolio_backtest,
+          py::arg("timestamps"),
+          py::arg("prices"),
+          py::arg("signals"),
+          py::arg("symbols"),
+          py::arg("initial_capital") = 10000.0,
+          py::arg("slippage") = 0.0005,
+          py::arg("latency") = 0.0,
+          py::arg("weights") = py::none(),
+          py::arg("include_series") = false,
+          "Run one strategy across many symbols. prices and signals are (times, symbols) "
+          "arrays; capital is split into per-symbol sleeves by weights (equal by default)");
+    
+    // Expose asynchronous backtests
+    py::class_<BacktestFuture>(m, "BacktestFuture")
+        .def("done", &BacktestFuture::done,
+             "Return True if the backtest has finished")
+        .def("wait", &BacktestFuture::wait, py::arg("timeout") = py::none(),
+             "Wait for the backtest; return False if the timeout expired")
+        .def("result", &BacktestFuture::result, py::arg("timeout") = py::none(),
+             "Return the results dict, waiting if necessary");
+    
+    m.def("run_backtest_async", &run_backtest_async,
+          py::arg("signals_file_path"),
+          py::arg("initial_capital") = 10000.0,
+          py::arg("slippage") = 0.0005,
+          py::arg("latency") = 0.0,
+          "Start a backtest on the engine's thread pool and return a BacktestFuture");
+    
+    // Expose the parameter sweep
+    m.def("run_parameter_sweep", &run_parameter_sweep,
+          py::arg("signals_file_path"),
+          py::arg("initial_capitals"),
+          py::arg("slippages"),
+          py::arg("latencies"),
+          py::arg("num_threads") = 0,
+          "Run every (initial_capital, slippage, latency) combination in parallel and "
+          "return a dict of NumPy columns (one row per configuration)");
+    
+    // Expose batched single-symbol backtests
+    m.def("run_backtests", &run_backtests,
+          py::arg("sources"),
+          py::arg("initial_capital") = 10000.0,
+          py::arg("slippage") = 0.0005,
+          py::arg("latency") = 0.0,
+          py::arg("num_threads") = 0,
+          "Run one backtest per source (a signal file path or a (timestamps, prices, signals) "
+          "tuple) in parallel and return a dict of NumPy columns (one row per source)");
+    
+    // Expose the fused technical indicator kernel
+    py::list indicatorColumns;
+    for (size_t column = 0; column < IndicatorEngine::kFeatureCount; ++column) {
+        indicatorColumns.append(IndicatorEngine::featureName(column));
+    }
+    m.attr("INDICATOR_COLUMNS") = indicatorColumns;
+    
+    m.def("compute_indicators", &compute_indicators,
+          py::arg("close"),
+          py::arg("out") = py::none(),
+          py::arg("num_threads") = 0,
+          "Compute the technical indicator features (columns named by INDICATOR_COLUMNS) of "
+          "a close series (1-D) or of each row of a (series, bars) array in one pass, writing "
+          "into out if given; rows before an indicator's window is filled hold NaN");
+    
+    // Expose the stateful indicators (O(1) per update, checkpointable)
+    py::class_<Sma> sma(m, "Sma");
+    sma.def(py::init<size_t>(), py::arg("window"))
+        .def("update", &Sma::update, py::arg("value"),
+             "Add the next value and return the average (NaN until the window is full)")
+        .def_property_readonly("value", &Sma::value)
+        .def_property_readonly("ready", &Sma::ready)
+        .def_property_readonly("window", &Sma::window)
+        .def("reset", &Sma::reset);
+    def_indicator_state(sma);
+    
+    py::class_<RollingStd> rollingStd(m, "RollingStd");
+    rollingStd.def(py::init<size_t>(), py::arg("window"))
+        .def("update", &RollingStd::update, py::arg("value"),
+             "Add the next value and return the sample standard deviation (NaN until the window is full)")
+        .def_property_readonly("value", &RollingStd::value)
+        .def_property_readonly("mean", &RollingStd::mean)
+        .def_property_readonly("ready", &RollingStd::ready)
+        .def_property_readonly("window", &RollingStd::window)
+        .def("reset", &RollingStd::reset);
+    def_indicator_state(rollingStd);
+    
+    py::class_<Ema> ema(m, "Ema");
+    ema.def(py::init<double>(), py::arg("span"))
+        .def("update", &Ema::update, py::arg("value"),
+             "Add the next value and return the average (pandas ewm(span, adjust=False))")
+        .def_property_readonly("value", &Ema::value)
+        .def_property_readonly("ready", &Ema::ready)
+        .def_property_readonly("span", &Ema::span)
+        .def("reset", &Ema::reset);
+    def_indicator_state(ema);
+    
+    py::class_<WilderRsi> wilderRsi(m, "WilderRsi");
+    wilderRsi.def(py::init<size_t>(), py::arg("period") = 14)
+        .def("update", &WilderRsi::update, py::arg("price"),
+             "Add the next price and return the RSI (NaN until `period` changes are seen)")
+        .def_property_readonly("value", &WilderRsi::value)
+        .def_property_readonly("ready", &WilderRsi::ready)
+        .def_property_readonly("period", &WilderRsi::period)
+        .def("reset", &WilderRsi::reset);
+    def_indicator_state(wilderRsi);
+    
+    py::class_<Macd> macd(m, "Macd");
+    macd.def(py::init<double, double, double>(),
+             py::arg("fast_span") = 12.0, py::arg("slow_span") = 26.0, py::arg("signal_span") = 9.0)
+        .def("update", &Macd::update, py::arg("price"),
+             "Add the next price and return the MACD line")
+        .def_property_readonly("value", &Macd::value)
+        .def_property_readonly("signal", &Macd::signal)
+        .def_property_readonly("histogram", &Macd::histogram)
+        .def_property_readonly("ready", &Macd::ready)
+        .def("reset", &Macd::reset);
+    def_indicator_state(macd);
+    
+    py::class_<IndicatorState> indicatorState(m, "IndicatorState");
+    indicatorState.def(py::init<>())
+        .def("update",
+             [](IndicatorState& self, double close) {
+                 py::array_t<double> row(static_cast<py::ssize_t>(IndicatorEngine::kFeatureCount));
+                 self.update(close, row.mutable_data());
+                 return row;
+             },
+             py::arg("close"),
+             "Add the next close and return its feature row (columns named by INDICATOR_COLUMNS)")
+        .def_property_readonly("bars", &IndicatorState::bars)
+        .def_property_readonly("ready", &IndicatorState::ready)
+        .def("reset", &IndicatorState::reset);
+    def_indicator_state(indicatorState);
+    
+    // Expose walk-forward analysis
+    m.def("walk_forward", &walk_forward,
+          py::arg("timestamps"),
+          py::arg("prices"),
+          py::arg("signals"),
+          py::arg("train_bars") = 252,
+          py::arg("test_bars") = 63,
+          py::arg("anchored") = false,
+          py::arg("initial_capital") = 10000.0,
+          py::arg("slippage") = 0.0005,
+          py::arg("latency") = 0.0,
+          py::arg("num_threads") = 0,
+          "Walk-forward analysis: roll train/test windows over the bars, pick the candidate "
+          "signal row (signals has shape (candidates, bars)) with the best in-sample Sharpe "
+          "on each training window and backtest it on the test window, entering at the close "
+          "of the last training bar. Folds run in parallel. The stitched curve trades the chosen "
+          "candidates back to back in one backtest, so positions carry across folds. "
+          "Returns the stitched out-of-sample results with 'timestamps' and 'equity' arrays, "
+          "and 'folds', a list of per-fold dicts with their windows, chosen candidate, "
+          "results and equity");
+    
+    // Expose native inference of exported signal models
+    py::class_<SignalModel>(m, "SignalModel")
+        .def(py::init(&load_signal_model), py::arg("model_path"),
+             "Load a model file written by SignalGenerator.export_model()")
+        .def("predict", &predict_signals, py::arg("features"),
+             "Predict an int8 signal for each row of a (rows, columns) feature matrix, "
+             "e.g. compute_indicators() output")
+        .def_property_readonly("kind",
+                               [](const SignalModel& self) {
+                                   return self.kind() == kModelLinear ? "linear" : "tree_ensemble";
+                               })
+        .def_property_readonly("feature_count", &SignalModel::featureCount)
+        .def_property_readonly("tree_count", &SignalModel::treeCount)
+        .def_property_readonly("node_count", &SignalModel::nodeCount);
+    
+    m.def("run_model_backtest", &run_model_backtest,
+          py::arg("timestamps"),
+          py::arg("close"),
+          py::arg("model"),
+          py::arg("initial_capital") = 10000.0,
+          py::arg("slippage") = 0.0005,
+          py::arg("latency") = 0.0,
+          py::arg("include_series") = false,
+          "Compute indicator features, predict signals with a SignalModel and backtest them "
+          "in one native pass (int64 epoch-ns timestamps, float64 close prices)");
+    
+    // Expose rolling-window metrics
+    m.def("rolling_metrics", &rolling_metrics,
+          py::arg("equity"),
+          py::arg("windows") = std::vector<size_t>{20, 60, 252},
+          py::arg("risk_free_rate") = 0.0,
+          py::arg("num_threads") = 0,
+          "Compute rolling volatility, Sharpe, Sortino and drawdown (percent) for every bar "
+          "of an equity curve (1-D) or of each row of a (runs, bars) array. Returns "
+          "{window: {name: array}} with arrays shaped like equity; the ratios are NaN "
+          "until a window's worth of returns is available");
     
     // Expose the Backtester class
     py::class_<Backtester>(m, "Backtester")
@@ -64,11 +1161,51 @@ PYBIND11_MODULE(quant_cpp_engine, m) {
              py::arg("initial_capital") = 10000.0, 
              py::arg("slippage") = 0.0005, 
              py::arg("latency") = 0.0)
-        .def("load_signals_from_csv", &Backtester::loadSignalsFromCSV)
-        .def("run_backtest", &Backtester::runBacktest)
+        .def("load_signals_from_csv", &Backtester::loadSignalsFromCSV,
+             py::call_guard<py::gil_scoped_release>())
+        .def("load_signals_from_binary", &Backtester::loadSignalsFromBinary,
+             py::call_guard<py::gil_scoped_release>())
+        .def("load_signals_from_file", &Backtester::loadSignalsFromFile,
+             py::call_guard<py::gil_scoped_release>())
+        .def("load_signals_from_arrays",
+             [](Backtester& self, const TimestampArray& timestamps, const PriceArray& prices, const SignalArray& signals) {
+                 self.setSignals(frame_from_arrays(timestamps, prices, signals));
+                 return !self.getSignals().empty();
+             },
+             py::arg("timestamps"), py::arg("prices"), py::arg("signals"),
+             "Use NumPy arrays as the signals; matching dtypes are borrowed without copying")
+        .def("run_backtest", &Backtester::runBacktest,
+             py::call_guard<py::gil_scoped_release>())
+        .def("begin_stream", &Backtester::beginStream,
+             "Reset the account and start feeding ticks with on_signal")
+        .def("on_signal", &Backtester::onSignal,
+             py::arg("timestamp"), py::arg("price"), py::arg("signal"),
+             "Process one tick (timestamp in nanoseconds since the epoch) in streaming mode")
+        .def("snapshot", &Backtester::snapshot,
+             "Return the current streaming BacktestResults in O(1)")
         .def("get_results", &Backtester::getResults)
+        .def("release_series",
+             [](Backtester& self) { return series_to_dict(self.releaseSeries()); },
+             "Move the equity, drawdown, return and trade series into NumPy arrays without "
+             "copying; the backtester's series are empty until the next run")
         .def("print_results", &Backtester::printResults);
     
+    // Expose timestamp conversion (the engine works in epoch nanoseconds)
+    m.def("parse_timestamp",
+          [](const std::string& text) {
+              int64_t nanos = 0;
+              if (!parseTimestamp(text.data(), text.data() + text.size(), nanos)) {
+                  throw py::value_error("Invalid timestamp: " + text);
+              }
+              return nanos;
+          },
+          py::arg("text"),
+          "Parse an ISO timestamp (as written by pandas) into nanoseconds since the epoch (UTC)");
+    
+    m.def("format_timestamp", &formatTimestamp,
+          py::arg("nanos"),
+          "Format nanoseconds since the epoch as 'YYYY-MM-DD HH:MM:SS' (UTC)");
+    
     // Expose the Signal struct
     py::class_<Signal>(m, "Signal")
         .def(py::init<>())
@@ -76,14 +1213,19 @@ PYBIND11_MODULE(quant_cpp_engine, m) {
         .def_readwrite("price", &Signal::price)
         .def_readwrite("signal", &Signal::signal);
     
-    // Expose the Trade struct
-    py::class_<Trade>(m, "Trade")
+    // Expose the trade record (action is the text form of side)
+    py::enum_<Side>(m, "Side")
+        .value("SELL", Side::Sell)
+        .value("BUY", Side::Buy);
+    
+    py::class_<TradeRecord>(m, "Trade")
         .def(py::init<>())
-        .def_readwrite("timestamp", &Trade::timestamp)
-        .def_readwrite("action", &Trade::action)
-        .def_readwrite("shares", &Trade::shares)
-        .def_readwrite("price", &Trade::price)
-        .def_readwrite("value", &Trade::value);
+        .def_readwrite("timestamp", &TradeRecord::timestamp)
+        .def_readwrite("side", &TradeRecord::side)
+        .def_property_readonly("action", [](const TradeRecord& trade) { return std::string(sideName(trade.side)); })
+        .def_readwrite("shares", &TradeRecord::shares)
+        .def_readwrite("price", &TradeRecord::price)
+        .def_readwrite("value", &TradeRecord::value);
     
     // Expose the BacktestResults struct
     py::class_<BacktestResults>(m, "BacktestResults")
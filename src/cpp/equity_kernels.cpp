@@ -0,0 +1,390 @@
+#include "equity_kernels.h"
+#include <algorithm>
+#include <atomic>
+
+// SIMD paths are compiled with per-function target attributes, so the rest
+// of the build needs no special flags and runs on any x86-64 CPU
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define EQUITY_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+double drawdownsScalar(const double* equity, size_t size, double& peak, double* drawdowns) {
+    double runningPeak = peak;
+    double maxDrawdown = 0.0;
+    for (size_t i = 0; i < size; ++i) {
+        runningPeak = std::max(runningPeak, equity[i]);
+        double drawdown = (runningPeak - equity[i]) / runningPeak;
+        maxDrawdown = std::max(maxDrawdown, drawdown);
+        if (drawdowns != nullptr) {
+            drawdowns[i] = drawdown * 100.0;
+        }
+    }
+    peak = runningPeak;
+    return maxDrawdown;
+}
+
+void returnsScalar(const double* equity, size_t size, double previous, double* returns) {
+    for (size_t i = 0; i < size; ++i) {
+        returns[i] = equity[i] / previous - 1.0;
+        previous = equity[i];
+    }
+}
+
+// Changes in [begin, size), given the signal before begin
+size_t countChangesScalar(const int8_t* signals, size_t begin, size_t size, int8_t previous) {
+    size_t count = 0;
+    for (size_t i = begin; i < size; ++i) {
+        count += signals[i] != previous;
+        previous = signals[i];
+    }
+    return count;
+}
+
+size_t findChangesScalar(const int8_t* signals, size_t begin, size_t size, int8_t previous, size_t* changes) {
+    size_t count = 0;
+    for (size_t i = begin; i < size; ++i) {
+        if (signals[i] != previous) {
+            changes[count++] = i;
+        }
+        previous = signals[i];
+    }
+    return count;
+}
+
+void fillEquityScalar(const double* prices, size_t size, double cash, int position, double* equity) {
+    if (position <= 0) {
+        std::fill(equity, equity + size, cash);
+        return;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        equity[i] = cash + position * prices[i];
+    }
+}
+
+#ifdef EQUITY_KERNELS_X86
+
+__attribute__((target("avx2")))
+double drawdownsAvx2(const double* equity, size_t size, double& peak, double* drawdowns) {
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    __m256d carry = _mm256_set1_pd(peak);
+    __m256d maxDrawdown = _mm256_setzero_pd();
+    
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        const __m256d x = _mm256_loadu_pd(equity + i);
+        
+        // Prefix max in two shift-and-max steps; repeating lane 0 instead of
+        // shifting in -inf is harmless because max is idempotent
+        __m256d running = _mm256_max_pd(x, _mm256_permute4x64_pd(x, _MM_SHUFFLE(2, 1, 0, 0)));
+        running = _mm256_max_pd(running, _mm256_permute4x64_pd(running, _MM_SHUFFLE(1, 0, 0, 0)));
+        running = _mm256_max_pd(running, carry);
+        carry = _mm256_permute4x64_pd(running, _MM_SHUFFLE(3, 3, 3, 3));
+        
+        const __m256d drawdown = _mm256_div_pd(_mm256_sub_pd(running, x), running);
+        maxDrawdown = _mm256_max_pd(maxDrawdown, drawdown);
+        if (drawdowns != nullptr) {
+            _mm256_storeu_pd(drawdowns + i, _mm256_mul_pd(drawdown, hundred));
+        }
+    }
+    
+    double lanes[4];
+    _mm256_storeu_pd(lanes, maxDrawdown);
+    double result = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+    
+    peak = _mm256_cvtsd_f64(carry);
+    double tail = drawdownsScalar(equity + i, size - i, peak, drawdowns != nullptr ? drawdowns + i : nullptr);
+    return std::max(result, tail);
+}
+
+__attribute__((target("avx2")))
+void returnsAvx2(const double* equity, size_t size, double previous, double* returns) {
+    if (size == 0) {
+        return;
+    }
+    returns[0] = equity[0] / previous - 1.0;
+    
+    const __m256d one = _mm256_set1_pd(1.0);
+    size_t i = 1;
+    for (; i + 4 <= size; i += 4) {
+        const __m256d current = _mm256_loadu_pd(equity + i);
+        const __m256d last = _mm256_loadu_pd(equity + i - 1);
+        _mm256_storeu_pd(returns + i, _mm256_sub_pd(_mm256_div_pd(current, last), one));
+    }
+    returnsScalar(equity + i, size - i, equity[i - 1], returns + i);
+}
+
+// Bit i of the mask is set when signals[i] != signals[i - 1]
+__attribute__((target("avx2")))
+inline uint32_t changeMaskAvx2(const int8_t* signals) {
+    const __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(signals));
+    const __m256i previous = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(signals - 1));
+    return ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(current, previous)));
+}
+
+__attribute__((target("avx2,popcnt")))
+size_t countChangesAvx2(const int8_t* signals, size_t size, int8_t previous) {
+    if (size == 0) {
+        return 0;
+    }
+    size_t count = signals[0] != previous;
+    size_t i = 1;
+    for (; i + 32 <= size; i += 32) {
+        count += __builtin_popcount(changeMaskAvx2(signals + i));
+    }
+    return count + countChangesScalar(signals, i, size, signals[i - 1]);
+}
+
+__attribute__((target("avx2,bmi")))
+size_t findChangesAvx2(const int8_t* signals, size_t size, int8_t previous, size_t* changes) {
+    if (size == 0) {
+        return 0;
+    }
+    size_t count = 0;
+    if (signals[0] != previous) {
+        changes[count++] = 0;
+    }
+    size_t i = 1;
+    for (; i + 32 <= size; i += 32) {
+        // Quiet stretches fall through with a single test
+        for (uint32_t mask = changeMaskAvx2(signals + i); mask != 0; mask &= mask - 1) {
+            changes[count++] = i + __builtin_ctz(mask);
+        }
+    }
+    return count + findChangesScalar(signals, i, size, signals[i - 1], changes + count);
+}
+
+__attribute__((target("avx2")))
+void fillEquityAvx2(const double* prices, size_t size, double cash, int position, double* equity) {
+    if (position <= 0) {
+        std::fill(equity, equity + size, cash);
+        return;
+    }
+    const __m256d cashLanes = _mm256_set1_pd(cash);
+    const __m256d shares = _mm256_set1_pd(position);
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        const __m256d value = _mm256_mul_pd(shares, _mm256_loadu_pd(prices + i));
+        _mm256_storeu_pd(equity + i, _mm256_add_pd(cashLanes, value));
+    }
+    fillEquityScalar(prices + i, size - i, cash, position, equity + i);
+}
+
+// GCC 12's AVX-512 intrinsics read an intentionally undefined register
+// and trip -Wmaybe-uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+__attribute__((target("avx512f")))
+double drawdownsAvx512(const double* equity, size_t size, double& peak, double* drawdowns) {
+    // Lane i reads lane max(i - k, 0) for k = 1, 2, 4
+    const __m512i shift1 = _mm512_set_epi64(6, 5, 4, 3, 2, 1, 0, 0);
+    const __m512i shift2 = _mm512_set_epi64(5, 4, 3, 2, 1, 0, 0, 0);
+    const __m512i shift4 = _mm512_set_epi64(3, 2, 1, 0, 0, 0, 0, 0);
+    const __m512i lastLane = _mm512_set1_epi64(7);
+    const __m512d hundred = _mm512_set1_pd(100.0);
+    __m512d carry = _mm512_set1_pd(peak);
+    __m512d maxDrawdown = _mm512_setzero_pd();
+    
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const __m512d x = _mm512_loadu_pd(equity + i);
+        
+        __m512d running = _mm512_max_pd(x, _mm512_permutexvar_pd(shift1, x));
+        running = _mm512_max_pd(running, _mm512_permutexvar_pd(shift2, running));
+        running = _mm512_max_pd(running, _mm512_permutexvar_pd(shift4, running));
+        running = _mm512_max_pd(running, carry);
+        carry = _mm512_permutexvar_pd(lastLane, running);
+        
+        const __m512d drawdown = _mm512_div_pd(_mm512_sub_pd(running, x), running);
+        maxDrawdown = _mm512_max_pd(maxDrawdown, drawdown);
+        if (drawdowns != nullptr) {
+            _mm512_storeu_pd(drawdowns + i, _mm512_mul_pd(drawdown, hundred));
+        }
+    }
+    
+    double lanes[8];
+    _mm512_storeu_pd(lanes, maxDrawdown);
+    double result = *std::max_element(lanes, lanes + 8);
+    peak = _mm512_cvtsd_f64(carry);
+    double tail = drawdownsScalar(equity + i, size - i, peak, drawdowns != nullptr ? drawdowns + i : nullptr);
+    return std::max(result, tail);
+}
+
+__attribute__((target("avx512f")))
+void returnsAvx512(const double* equity, size_t size, double previous, double* returns) {
+    if (size == 0) {
+        return;
+    }
+    returns[0] = equity[0] / previous - 1.0;
+    
+    const __m512d one = _mm512_set1_pd(1.0);
+    size_t i = 1;
+    for (; i + 8 <= size; i += 8) {
+        const __m512d current = _mm512_loadu_pd(equity + i);
+        const __m512d last = _mm512_loadu_pd(equity + i - 1);
+        _mm512_storeu_pd(returns + i, _mm512_sub_pd(_mm512_div_pd(current, last), one));
+    }
+    returnsScalar(equity + i, size - i, equity[i - 1], returns + i);
+}
+
+__attribute__((target("avx512f,avx512bw,popcnt")))
+size_t countChangesAvx512(const int8_t* signals, size_t size, int8_t previous) {
+    if (size == 0) {
+        return 0;
+    }
+    size_t count = signals[0] != previous;
+    size_t i = 1;
+    for (; i + 64 <= size; i += 64) {
+        const __m512i current = _mm512_loadu_si512(signals + i);
+        const __m512i last = _mm512_loadu_si512(signals + i - 1);
+        count += __builtin_popcountll(_mm512_cmpneq_epi8_mask(current, last));
+    }
+    return count + countChangesScalar(signals, i, size, signals[i - 1]);
+}
+
+__attribute__((target("avx512f,avx512bw,bmi")))
+size_t findChangesAvx512(const int8_t* signals, size_t size, int8_t previous, size_t* changes) {
+    if (size == 0) {
+        return 0;
+    }
+    size_t count = 0;
+    if (signals[0] != previous) {
+        changes[count++] = 0;
+    }
+    size_t i = 1;
+    for (; i + 64 <= size; i += 64) {
+        const __m512i current = _mm512_loadu_si512(signals + i);
+        const __m512i last = _mm512_loadu_si512(signals + i - 1);
+        for (uint64_t mask = _mm512_cmpneq_epi8_mask(current, last); mask != 0; mask &= mask - 1) {
+            changes[count++] = i + __builtin_ctzll(mask);
+        }
+    }
+    return count + findChangesScalar(signals, i, size, signals[i - 1], changes + count);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // EQUITY_KERNELS_X86
+
+std::atomic<int>& activeLevel() {
+    static std::atomic<int> level(static_cast<int>(detectSimdLevel()));
+    return level;
+}
+
+} // namespace
+
+SimdLevel detectSimdLevel() {
+#ifdef EQUITY_KERNELS_X86
+    static const SimdLevel detected = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+            return SimdLevel::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::AVX2;
+        }
+        return SimdLevel::Scalar;
+    }();
+    return detected;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel simdLevel() {
+    return static_cast<SimdLevel>(activeLevel().load(std::memory_order_relaxed));
+}
+
+void setSimdLevel(SimdLevel level) {
+    level = std::min(level, detectSimdLevel());
+    activeLevel().store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512:
+            return "avx512";
+        case SimdLevel::AVX2:
+            return "avx2";
+        default:
+            return "scalar";
+    }
+}
+
+double computeDrawdowns(const double* equity, size_t size, double& peak, double* drawdowns) {
+    switch (simdLevel()) {
+#ifdef EQUITY_KERNELS_X86
+        case SimdLevel::AVX512:
+            return drawdownsAvx512(equity, size, peak, drawdowns);
+        case SimdLevel::AVX2:
+            return drawdownsAvx2(equity, size, peak, drawdowns);
+#endif
+        default:
+            return drawdownsScalar(equity, size, peak, drawdowns);
+    }
+}
+
+void computeReturns(const double* equity, size_t size, double previous, double* returns) {
+    switch (simdLevel()) {
+#ifdef EQUITY_KERNELS_X86
+        case SimdLevel::AVX512:
+            returnsAvx512(equity, size, previous, returns);
+            return;
+        case SimdLevel::AVX2:
+            returnsAvx2(equity, size, previous, returns);
+            return;
+#endif
+        default:
+            returnsScalar(equity, size, previous, returns);
+            return;
+    }
+}
+
+size_t countSignalChanges(const int8_t* signals, size_t size, int8_t previous) {
+    switch (simdLevel()) {
+#ifdef EQUITY_KERNELS_X86
+        case SimdLevel::AVX512:
+            return countChangesAvx512(signals, size, previous);
+        case SimdLevel::AVX2:
+            return countChangesAvx2(signals, size, previous);
+#endif
+        default:
+            return countChangesScalar(signals, 0, size, previous);
+    }
+}
+
+size_t findSignalChanges(const int8_t* signals, size_t size, int8_t previous, size_t* changes) {
+    switch (simdLevel()) {
+#ifdef EQUITY_KERNELS_X86
+        case SimdLevel::AVX512:
+            return findChangesAvx512(signals, size, previous, changes);
+        case SimdLevel::AVX2:
+            return findChangesAvx2(signals, size, previous, changes);
+#endif
+        default:
+            return findChangesScalar(signals, 0, size, previous, changes);
+    }
+}
+
+void fillEquity(const double* prices, size_t size, double cash, int position, double* equity) {
+    switch (simdLevel()) {
+#ifdef EQUITY_KERNELS_X86
+        // AVX-512 targets also enable FMA, which would round cash + position * price
+        // differently from Account::equity(); the fill is memory-bound anyway
+        case SimdLevel::AVX512:
+        case SimdLevel::AVX2:
+            fillEquityAvx2(prices, size, cash, position, equity);
+            return;
+#endif
+        default:
+            fillEquityScalar(prices, size, cash, position, equity);
+            return;
+    }
+}
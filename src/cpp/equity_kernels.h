@@ -0,0 +1,109 @@
+#ifndef EQUITY_KERNELS_H
+#define EQUITY_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Instruction set used by the equity kernels (AVX512 needs the F and BW subsets)
+ */
+enum class SimdLevel {
+    Scalar = 0,
+    AVX2 = 1,
+    AVX512 = 2
+};
+
+/**
+ * Best instruction set supported by this CPU (and build)
+ *
+ * @return Detected level
+ */
+SimdLevel detectSimdLevel();
+
+/**
+ * Instruction set the kernels currently dispatch to
+ *
+ * Defaults to detectSimdLevel().
+ *
+ * @return Active level
+ */
+SimdLevel simdLevel();
+
+/**
+ * Force the kernels to a lower instruction set (e.g. for benchmarking)
+ *
+ * Levels above detectSimdLevel() are clamped to it.
+ *
+ * @param level Requested level
+ */
+void setSimdLevel(SimdLevel level);
+
+/**
+ * Name of an instruction set level ("scalar", "avx2" or "avx512")
+ */
+const char* simdLevelName(SimdLevel level);
+
+/**
+ * Running-peak drawdowns of an equity curve
+ *
+ * Computes the running peak as a vectorized prefix max, then
+ * (peak - equity) / peak for every point. Results are identical to the
+ * scalar loop on every instruction set.
+ *
+ * @param equity Equity values
+ * @param size Number of values
+ * @param peak Peak before the first value; updated to the peak after the last
+ * @param drawdowns Output drawdown percentage per value (may be nullptr)
+ * @return Maximum drawdown as a fraction (not percent)
+ */
+double computeDrawdowns(const double* equity, size_t size, double& peak, double* drawdowns);
+
+/**
+ * Simple returns of an equity curve
+ *
+ * @param equity Equity values
+ * @param size Number of values
+ * @param previous Equity before the first value
+ * @param returns Output equity[i] / equity[i - 1] - 1 per value
+ */
+void computeReturns(const double* equity, size_t size, double previous, double* returns);
+
+/**
+ * Number of rows whose signal differs from the row before
+ *
+ * @param signals Signal per row
+ * @param size Number of rows
+ * @param previous Signal before the first row
+ * @return Number of changes
+ */
+size_t countSignalChanges(const int8_t* signals, size_t size, int8_t previous);
+
+/**
+ * Rows whose signal differs from the row before, in increasing order
+ *
+ * Compares whole vectors of signals at a time, so long runs of unchanged
+ * signals cost a compare and a mask test per vector.
+ *
+ * @param signals Signal per row
+ * @param size Number of rows
+ * @param previous Signal before the first row
+ * @param changes Output row indices (room for countSignalChanges() entries)
+ * @return Number of changes written
+ */
+size_t findSignalChanges(const int8_t* signals, size_t size, int8_t previous, size_t* changes);
+
+/**
+ * Mark a constant single-asset account to market over a run of prices
+ *
+ * Matches Account::equity(): cash plus position * price, or just the cash
+ * when flat.
+ *
+ * @param prices Price per row
+ * @param size Number of rows
+ * @param cash Account cash
+ * @param position Account position in shares
+ * @param equity Output equity per row
+ */
+void fillEquity(const double* prices, size_t size, double cash, int position, double* equity);
+
+#endif // EQUITY_KERNELS_H
@@ -0,0 +1,224 @@
+#ifndef EXECUTION_ENGINE_H
+#define EXECUTION_ENGINE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "equity_kernels.h"
+#include "signal_frame.h"
+#include "trade_record.h"
+
+/**
+ * Cash and position of a single-asset account
+ */
+struct Account {
+    double cash = 0.0;
+    int position = 0;
+    
+    /**
+     * Mark the account to market
+     * 
+     * @param price Current price
+     * @return Cash plus the value of the position
+     */
+    double equity(double price) const {
+        return position > 0 ? cash + position * price : cash;
+    }
+};
+
+/**
+ * Slippage policy: buys pay and sells receive a fixed fraction of the price
+ */
+struct ProportionalSlippage {
+    double rate = 0.0;  // 0.001 = 0.1%
+    
+    double buyPrice(double basePrice) const { return basePrice * (1.0 + rate); }
+    double sellPrice(double basePrice) const { return basePrice * (1.0 - rate); }
+};
+
+/**
+ * Slippage policy: orders fill at the base price
+ */
+struct NoSlippage {
+    double buyPrice(double basePrice) const { return basePrice; }
+    double sellPrice(double basePrice) const { return basePrice; }
+};
+
+/**
+ * Latency policy: orders fill on the row that triggered them
+ */
+struct NoLatency {
+    size_t fillRow(const SignalFrame&, size_t row) { return row; }
+};
+
+/**
+ * Latency policy: orders fill at the first row at or after the trigger time
+ * plus a delay (the last row if the data ends first)
+ *
+ * Keeps a forward cursor, so one instance must only see increasing rows.
+ */
+class SearchLatency {
+public:
+    explicit SearchLatency(int64_t delay) : m_delay(delay), m_cursor(0) {}
+    
+    size_t fillRow(const SignalFrame& frame, size_t row) {
+        // Fill times only move forward, so each search starts where the last ended
+        m_cursor = frame.seek(frame.timestamp(row) + m_delay, std::max(m_cursor, row));
+        return std::min(m_cursor, frame.size() - 1);
+    }
+    
+private:
+    int64_t m_delay;  // Nanoseconds
+    size_t m_cursor;
+};
+
+/**
+ * Latency policy: fill rows read from a SignalFrame::forwardIndex() table
+ */
+class TableLatency {
+public:
+    explicit TableLatency(const size_t* fillRows) : m_fillRows(fillRows) {}
+    
+    size_t fillRow(const SignalFrame&, size_t row) const { return m_fillRows[row]; }
+    
+private:
+    const size_t* m_fillRows;
+};
+
+/**
+ * Sizing policy: buy as many whole shares as the cash allows
+ */
+struct AllInSizing {
+    int shares(double cash, double price) const { return static_cast<int>(cash / price); }
+};
+
+/**
+ * Sizing policy: buy up to a fixed notional per trade, limited by the cash
+ */
+struct FixedNotionalSizing {
+    double notional = 10000.0;
+    
+    int shares(double cash, double price) const { return static_cast<int>(std::min(notional, cash) / price); }
+};
+
+/**
+ * Single-asset execution core shared by Backtester and TradeSimulator
+ *
+ * Slippage, latency and position sizing are compile-time policies, so each
+ * combination gets its own fully inlined loop with no virtual calls. A
+ * signal change to 1 buys from flat and a change to 0 sells the whole
+ * position. Latency policies may keep search state, so use one engine per run.
+ */
+template <typename SlippageModel, typename LatencyModel, typename SizingModel>
+class ExecutionEngine {
+public:
+    explicit ExecutionEngine(SlippageModel slippage = SlippageModel(),
+                             LatencyModel latency = LatencyModel(),
+                             SizingModel sizing = SizingModel())
+        : m_slippage(slippage), m_latency(latency), m_sizing(sizing) {}
+    
+    /**
+     * Execute a target signal against the account if it calls for a trade
+     * 
+     * @param account Account to trade
+     * @param signal Target signal (1 = buy, 0 = sell)
+     * @param basePrice Execution price before slippage
+     * @param timestamp Trade time in nanoseconds since the Unix epoch
+     * @param onFill Called with the TradeRecord of each fill
+     */
+    template <typename OnFill>
+    void execute(Account& account, int signal, double basePrice, int64_t timestamp, OnFill&& onFill) const {
+        if (signal == 1 && account.position == 0) {
+            const double price = m_slippage.buyPrice(basePrice);
+            const int shares = m_sizing.shares(account.cash, price);
+            if (shares > 0) {
+                account.position = shares;
+                account.cash -= shares * price;
+                onFill(TradeRecord{timestamp, price, shares * price, shares, Side::Buy, {}});
+            }
+        } else if (signal == 0 && account.position > 0) {
+            const double price = m_slippage.sellPrice(basePrice);
+            const double proceeds = account.position * price;
+            onFill(TradeRecord{timestamp, price, proceeds, account.position, Side::Sell, {}});
+            account.cash += proceeds;
+            account.position = 0;
+        }
+    }
+    
+    /**
+     * Run the account over every row of a signal frame
+     * 
+     * @param frame Signals
+     * @param account Account to trade (starts flat or wherever the caller left it)
+     * @param onFill Called with the TradeRecord of each fill
+     * @param onBar Called with (row, equity) after each row is processed
+     */
+    template <typename OnFill, typename OnBar>
+    void run(const SignalFrame& frame, Account& account, OnFill&& onFill, OnBar&& onBar) {
+        const size_t numSignals = frame.size();
+        const int64_t* timestamps = frame.timestamps();
+        const double* prices = frame.prices();
+        const int8_t* signals = frame.signals();
+        
+        int currentSignal = 0;
+        for (size_t i = 0; i < numSignals; ++i) {
+            const double price = prices[i];
+            const int signal = signals[i];
+            
+            // Trade on signal changes at the latency-adjusted price
+            if (signal != currentSignal) {
+                execute(account, signal, prices[m_latency.fillRow(frame, i)], timestamps[i], onFill);
+                currentSignal = signal;
+            }
+            
+            onBar(i, account.equity(price));
+        }
+    }
+    
+    /**
+     * Run the account over a signal frame, visiting only the rows where
+     * the signal changes
+     * 
+     * Produces the same fills and equity as run(). Between two changes the
+     * account is constant, so its equity is filled in with fillEquity().
+     * 
+     * @param frame Signals
+     * @param account Account to trade (starts flat or wherever the caller left it)
+     * @param changes Rows whose signal differs from the row before, in
+     *                increasing order (findSignalChanges() with previous = 0)
+     * @param numChanges Number of entries in changes
+     * @param onFill Called with the TradeRecord of each fill
+     * @param equity Output equity per row (nullptr = fills only)
+     */
+    template <typename OnFill>
+    void runChanges(const SignalFrame& frame, Account& account, const size_t* changes, size_t numChanges,
+                    OnFill&& onFill, double* equity) {
+        const int64_t* timestamps = frame.timestamps();
+        const double* prices = frame.prices();
+        const int8_t* signals = frame.signals();
+        
+        size_t begin = 0;
+        for (size_t k = 0; k < numChanges; ++k) {
+            const size_t row = changes[k];
+            if (equity != nullptr) {
+                fillEquity(prices + begin, row - begin, account.cash, account.position, equity + begin);
+            }
+            execute(account, signals[row], prices[m_latency.fillRow(frame, row)], timestamps[row], onFill);
+            begin = row;
+        }
+        if (equity != nullptr) {
+            fillEquity(prices + begin, frame.size() - begin, account.cash, account.position, equity + begin);
+        }
+    }
+    
+    const SlippageModel& slippage() const { return m_slippage; }
+    const LatencyModel& latency() const { return m_latency; }
+    const SizingModel& sizing() const { return m_sizing; }
+    
+private:
+    SlippageModel m_slippage;
+    LatencyModel m_latency;
+    SizingModel m_sizing;
+};
+
+#endif // EXECUTION_ENGINE_H
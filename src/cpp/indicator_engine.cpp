@@ -0,0 +1,253 @@
+#include "indicator_engine.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const char* const kFeatureNames[IndicatorEngine::kFeatureCount] = {
+    "Returns", "MA5", "MA10", "MA20", "RSI", "MA20_std",
+    "Upper_Band", "Lower_Band", "EMA12", "EMA26", "MACD", "Signal_Line"
+};
+
+constexpr size_t kShortWindow = 5;
+constexpr size_t kMediumWindow = 10;
+constexpr size_t kLongWindow = 20;
+constexpr size_t kRsiWindow = 14;
+constexpr double kBandWidth = 2.0;
+
+constexpr uint32_t kIndicatorStateTag = makeStateTag('I', 'N', 'D', '1');
+
+/**
+ * Recompute the running close sums and 20-bar moments from the last 20 closes
+ */
+void resyncWindows(const double* window, double& sum5, double& sum10, double& sum20, double& mean20, double& m2) {
+    sum5 = 0.0;
+    sum10 = 0.0;
+    sum20 = 0.0;
+    for (size_t j = 0; j < kLongWindow; ++j) {
+        sum20 += window[j];
+        if (j >= kLongWindow - kMediumWindow) {
+            sum10 += window[j];
+        }
+        if (j >= kLongWindow - kShortWindow) {
+            sum5 += window[j];
+        }
+    }
+    mean20 = sum20 / kLongWindow;
+    m2 = 0.0;
+    for (size_t j = 0; j < kLongWindow; ++j) {
+        m2 += (window[j] - mean20) * (window[j] - mean20);
+    }
+}
+
+} // namespace
+
+const char* IndicatorEngine::featureName(size_t column) {
+    return column < kFeatureCount ? kFeatureNames[column] : nullptr;
+}
+
+void IndicatorEngine::compute(const double* close, size_t size, double* features, size_t rowStride) {
+    if (rowStride == 0) {
+        rowStride = kFeatureCount;
+    }
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    
+    // Running window sums of closes
+    double sum5 = 0.0;
+    double sum10 = 0.0;
+    double sum20 = 0.0;
+    
+    // Sliding Welford moments of the last 20 closes
+    double mean20 = 0.0;
+    double m2 = 0.0;
+    size_t repeats = 0;  // Run of identical closes ending at the current bar
+    
+    // Gains and losses of the last 14 bars; the first bar counts as zero
+    // (pandas replaces its NaN difference with 0), and the nonzero counts
+    // keep an all-zero window's sum exactly zero
+    double gains[kRsiWindow] = {};
+    double losses[kRsiWindow] = {};
+    double gainSum = 0.0;
+    double lossSum = 0.0;
+    size_t gainCount = 0;
+    size_t lossCount = 0;
+    
+    Ema ema12(12.0);
+    Ema ema26(26.0);
+    Ema signalEma(9.0);
+    
+    for (size_t i = 0; i < size; ++i) {
+        const double price = close[i];
+        double* row = features + i * rowStride;
+        
+        // Returns
+        row[static_cast<size_t>(Indicator::Returns)] = i > 0 ? price / close[i - 1] - 1.0 : nan;
+        
+        // Moving averages
+        sum5 += price;
+        sum10 += price;
+        sum20 += price;
+        if (i >= kShortWindow) {
+            sum5 -= close[i - kShortWindow];
+        }
+        if (i >= kMediumWindow) {
+            sum10 -= close[i - kMediumWindow];
+        }
+        if (i >= kLongWindow) {
+            sum20 -= close[i - kLongWindow];
+        }
+        row[static_cast<size_t>(Indicator::MA5)] = i + 1 >= kShortWindow ? sum5 / kShortWindow : nan;
+        row[static_cast<size_t>(Indicator::MA10)] = i + 1 >= kMediumWindow ? sum10 / kMediumWindow : nan;
+        const double ma20 = i + 1 >= kLongWindow ? sum20 / kLongWindow : nan;
+        row[static_cast<size_t>(Indicator::MA20)] = ma20;
+        
+        // RSI
+        const size_t slot = i % kRsiWindow;
+        const double delta = i > 0 ? price - close[i - 1] : 0.0;
+        const double gain = std::max(delta, 0.0);
+        const double loss = std::max(-delta, 0.0);
+        if (i >= kRsiWindow) {
+            gainSum -= gains[slot];
+            lossSum -= losses[slot];
+            gainCount -= gains[slot] != 0.0;
+            lossCount -= losses[slot] != 0.0;
+        }
+        gains[slot] = gain;
+        losses[slot] = loss;
+        gainSum += gain;
+        lossSum += loss;
+        gainCount += gain != 0.0;
+        lossCount += loss != 0.0;
+        gainSum = gainCount > 0 ? std::max(gainSum, 0.0) : 0.0;
+        lossSum = lossCount > 0 ? std::max(lossSum, 0.0) : 0.0;
+        if (i + 1 >= kRsiWindow) {
+            // A window without losses gives 100 and one without any change NaN, as in pandas
+            const double rs = (gainSum / kRsiWindow) / (lossSum / kRsiWindow);
+            row[static_cast<size_t>(Indicator::RSI)] = 100.0 - 100.0 / (1.0 + rs);
+        } else {
+            row[static_cast<size_t>(Indicator::RSI)] = nan;
+        }
+        
+        // Bollinger bands
+        if (i < kLongWindow) {
+            const double deltaMean = price - mean20;
+            mean20 += deltaMean / static_cast<double>(i + 1);
+            m2 += deltaMean * (price - mean20);
+        } else {
+            const double leaving = close[i - kLongWindow];
+            const double oldMean = mean20;
+            mean20 += (price - leaving) / kLongWindow;
+            m2 += (price - leaving) * (price - mean20 + leaving - oldMean);
+            m2 = std::max(m2, 0.0);
+        }
+        // A window of identical closes has exactly zero deviation (as in pandas)
+        repeats = i > 0 && price == close[i - 1] ? repeats + 1 : 1;
+        if (repeats >= kLongWindow) {
+            mean20 = price;
+            m2 = 0.0;
+        } else if (i >= kLongWindow && i % kLongWindow == 0) {
+            // Once per window, recompute the close sums and moments from the
+            // window itself so rounding from the running updates cannot build up
+            resyncWindows(close + i + 1 - kLongWindow, sum5, sum10, sum20, mean20, m2);
+        }
+        if (i + 1 >= kLongWindow) {
+            const double stdDev = std::sqrt(m2 / (kLongWindow - 1));
+            row[static_cast<size_t>(Indicator::MA20Std)] = stdDev;
+            row[static_cast<size_t>(Indicator::UpperBand)] = ma20 + stdDev * kBandWidth;
+            row[static_cast<size_t>(Indicator::LowerBand)] = ma20 - stdDev * kBandWidth;
+        } else {
+            row[static_cast<size_t>(Indicator::MA20Std)] = nan;
+            row[static_cast<size_t>(Indicator::UpperBand)] = nan;
+            row[static_cast<size_t>(Indicator::LowerBand)] = nan;
+        }
+        
+        // MACD
+        const double fast = ema12.update(price);
+        const double slow = ema26.update(price);
+        const double macd = fast - slow;
+        row[static_cast<size_t>(Indicator::EMA12)] = fast;
+        row[static_cast<size_t>(Indicator::EMA26)] = slow;
+        row[static_cast<size_t>(Indicator::MACD)] = macd;
+        row[static_cast<size_t>(Indicator::SignalLine)] = signalEma.update(macd);
+    }
+}
+
+IndicatorState::IndicatorState()
+    : m_bars(0),
+      m_lastClose(0.0),
+      m_ma5(kShortWindow),
+      m_ma10(kMediumWindow),
+      m_ma20(kLongWindow),
+      m_gains(kRsiWindow),
+      m_losses(kRsiWindow),
+      m_std20(kLongWindow),
+      m_macd(12.0, 26.0, 9.0) {}
+
+void IndicatorState::reset() {
+    *this = IndicatorState();
+}
+
+void IndicatorState::update(double close, double* row) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    
+    // The first bar's change counts as zero, as in IndicatorEngine::compute
+    const double delta = m_bars > 0 ? close - m_lastClose : 0.0;
+    row[static_cast<size_t>(Indicator::Returns)] = m_bars > 0 ? close / m_lastClose - 1.0 : nan;
+    m_lastClose = close;
+    ++m_bars;
+    
+    row[static_cast<size_t>(Indicator::MA5)] = m_ma5.update(close);
+    row[static_cast<size_t>(Indicator::MA10)] = m_ma10.update(close);
+    const double ma20 = m_ma20.update(close);
+    row[static_cast<size_t>(Indicator::MA20)] = ma20;
+    
+    const double gain = m_gains.update(std::max(delta, 0.0));
+    const double loss = m_losses.update(std::max(-delta, 0.0));
+    row[static_cast<size_t>(Indicator::RSI)] = 100.0 - 100.0 / (1.0 + gain / loss);
+    
+    const double stdDev = m_std20.update(close);
+    row[static_cast<size_t>(Indicator::MA20Std)] = stdDev;
+    row[static_cast<size_t>(Indicator::UpperBand)] = ma20 + stdDev * kBandWidth;
+    row[static_cast<size_t>(Indicator::LowerBand)] = ma20 - stdDev * kBandWidth;
+    
+    const double macd = m_macd.update(close);
+    row[static_cast<size_t>(Indicator::EMA12)] = m_macd.fast();
+    row[static_cast<size_t>(Indicator::EMA26)] = m_macd.slow();
+    row[static_cast<size_t>(Indicator::MACD)] = macd;
+    row[static_cast<size_t>(Indicator::SignalLine)] = m_macd.signal();
+}
+
+void IndicatorState::save(StateWriter& writer) const {
+    writer.write(kIndicatorStateTag);
+    writer.write<uint64_t>(m_bars);
+    writer.write(m_lastClose);
+    m_ma5.save(writer);
+    m_ma10.save(writer);
+    m_ma20.save(writer);
+    m_gains.save(writer);
+    m_losses.save(writer);
+    m_std20.save(writer);
+    m_macd.save(writer);
+}
+
+IndicatorState IndicatorState::load(StateReader& reader) {
+    reader.expectTag(kIndicatorStateTag);
+    IndicatorState state;
+    state.m_bars = static_cast<size_t>(reader.read<uint64_t>());
+    state.m_lastClose = reader.read<double>();
+    state.m_ma5 = Sma::load(reader);
+    state.m_ma10 = Sma::load(reader);
+    state.m_ma20 = Sma::load(reader);
+    state.m_gains = Sma::load(reader);
+    state.m_losses = Sma::load(reader);
+    state.m_std20 = RollingStd::load(reader);
+    state.m_macd = Macd::load(reader);
+    if (state.m_ma5.window() != kShortWindow || state.m_ma10.window() != kMediumWindow ||
+        state.m_ma20.window() != kLongWindow || state.m_gains.window() != kRsiWindow ||
+        state.m_losses.window() != kRsiWindow || state.m_std20.window() != kLongWindow) {
+        throw std::invalid_argument("Indicator state has different windows");
+    }
+    return state;
+}
@@ -0,0 +1,121 @@
+#ifndef INDICATOR_ENGINE_H
+#define INDICATOR_ENGINE_H
+
+#include <cstddef>
+#include <string>
+#include "indicators.h"
+
+/**
+ * Columns of the technical indicator feature matrix, in order
+ *
+ * Names and definitions match FeatureEngineering.add_technical_indicators
+ * in signal_generation.py.
+ */
+enum class Indicator : size_t {
+    Returns,     // Simple return from the previous close
+    MA5,         // 5-bar simple moving average
+    MA10,        // 10-bar simple moving average
+    MA20,        // 20-bar simple moving average
+    RSI,         // 14-bar RSI from simple averages of gains and losses
+    MA20Std,     // 20-bar sample standard deviation
+    UpperBand,   // MA20 + 2 standard deviations
+    LowerBand,   // MA20 - 2 standard deviations
+    EMA12,       // 12-bar exponential moving average
+    EMA26,       // 26-bar exponential moving average
+    MACD,        // EMA12 - EMA26
+    SignalLine,  // 9-bar exponential moving average of MACD
+    Count
+};
+
+/**
+ * IndicatorEngine class for computing the technical indicator features of
+ * a close price series in one fused pass
+ *
+ * Every indicator is advanced together, bar by bar, with running window
+ * sums and exponential averages, so each close is read once (plus the
+ * closes leaving the windows, still in cache) and each bar's features are
+ * written as one contiguous row. Rows before an indicator's window is
+ * filled hold NaN for it, as the pandas rolling functions do.
+ */
+class IndicatorEngine {
+public:
+    static constexpr size_t kFeatureCount = static_cast<size_t>(Indicator::Count);
+    
+    /**
+     * Index of the first row in which every indicator window is filled
+     */
+    static constexpr size_t kWarmupRows = 19;
+    
+    /**
+     * Get the column name of a feature (as used by the pandas implementation)
+     * 
+     * @param column Feature column index
+     * @return Column name, or nullptr if the index is out of range
+     */
+    static const char* featureName(size_t column);
+    
+    /**
+     * Compute every feature for a close price series
+     * 
+     * @param close Close prices
+     * @param size Number of prices
+     * @param features Output row-major matrix with size rows of kFeatureCount values
+     * @param rowStride Distance between rows in values (0 = kFeatureCount); lets
+     *                  the features fill a column range of a wider matrix
+     */
+    static void compute(const double* close, size_t size, double* features, size_t rowStride = 0);
+};
+
+/**
+ * Streaming state of the IndicatorEngine features
+ *
+ * Produces the feature row of one new bar in O(1) from stateful
+ * indicators, so a live process does not recompute the history on every
+ * bar. Rows match IndicatorEngine::compute over the same closes up to
+ * rounding. The state can be saved and restored to resume from a
+ * checkpoint without replaying the history.
+ */
+class IndicatorState {
+public:
+    IndicatorState();
+    
+    /**
+     * Add the next close and compute its feature row
+     * 
+     * @param close Close price
+     * @param row Output row of IndicatorEngine::kFeatureCount values
+     */
+    void update(double close, double* row);
+    
+    /**
+     * Get the number of closes seen
+     * 
+     * @return Number of bars
+     */
+    size_t bars() const { return m_bars; }
+    
+    /**
+     * Check whether every indicator window is filled
+     * 
+     * @return True once bars() exceeds IndicatorEngine::kWarmupRows
+     */
+    bool ready() const { return m_bars > IndicatorEngine::kWarmupRows; }
+    
+    void reset();
+    
+    void save(StateWriter& writer) const;
+    static IndicatorState load(StateReader& reader);
+    
+private:
+    size_t m_bars;
+    double m_lastClose;
+    Sma m_ma5;
+    Sma m_ma10;
+    Sma m_ma20;
+    Sma m_gains;
+    Sma m_losses;
+    RollingStd m_std20;
+    Macd m_macd;
+};
+
+#endif // INDICATOR_ENGINE_H
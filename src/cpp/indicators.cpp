@@ -0,0 +1,335 @@
+#include "indicators.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr uint32_t kSmaTag = makeStateTag('S', 'M', 'A', '1');
+constexpr uint32_t kRollingStdTag = makeStateTag('S', 'T', 'D', '1');
+constexpr uint32_t kEmaTag = makeStateTag('E', 'M', 'A', '1');
+constexpr uint32_t kWilderRsiTag = makeStateTag('R', 'S', 'I', '1');
+constexpr uint32_t kMacdTag = makeStateTag('M', 'C', 'D', '1');
+
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * Read a ring buffer position and check it against the buffer
+ */
+size_t readIndex(StateReader& reader, size_t limit) {
+    uint64_t index = reader.read<uint64_t>();
+    if (index > limit) {
+        throw std::invalid_argument("Indicator state is corrupt");
+    }
+    return static_cast<size_t>(index);
+}
+
+/**
+ * Read a ring buffer's window and check that the buffer after it fits in
+ * the rest of the state, before the buffer is allocated
+ */
+size_t readWindow(StateReader& reader) {
+    uint64_t window = reader.read<uint64_t>();
+    if (window > reader.remaining() / sizeof(double)) {
+        throw std::invalid_argument("Indicator state is truncated");
+    }
+    return static_cast<size_t>(window);
+}
+
+} // namespace
+
+Sma::Sma(size_t window) : m_window(window), m_values(window) {
+    if (window == 0) {
+        throw std::invalid_argument("SMA window must be positive");
+    }
+    reset();
+}
+
+void Sma::reset() {
+    m_next = 0;
+    m_count = 0;
+    m_nonzero = 0;
+    m_sinceResync = 0;
+    m_sum = 0.0;
+}
+
+double Sma::update(double value) {
+    if (m_count == m_window) {
+        double leaving = m_values[m_next];
+        m_sum -= leaving;
+        m_nonzero -= leaving != 0.0;
+        ++m_sinceResync;
+    } else {
+        ++m_count;
+    }
+    m_values[m_next] = value;
+    m_next = m_next + 1 == m_window ? 0 : m_next + 1;
+    m_sum += value;
+    m_nonzero += value != 0.0;
+    
+    if (m_nonzero == 0) {
+        m_sum = 0.0;
+        m_sinceResync = 0;
+    } else if (m_sinceResync >= m_window) {
+        // Once per window length, so still O(1) per update amortized
+        m_sum = 0.0;
+        for (size_t i = 0; i < m_window; ++i) {
+            size_t slot = m_next + i;
+            m_sum += m_values[slot >= m_window ? slot - m_window : slot];
+        }
+        m_sinceResync = 0;
+    }
+    return this->value();
+}
+
+double Sma::value() const {
+    return ready() ? m_sum / static_cast<double>(m_window) : kNaN;
+}
+
+void Sma::save(StateWriter& writer) const {
+    writer.write(kSmaTag);
+    writer.write<uint64_t>(m_window);
+    writer.write(m_values);
+    writer.write<uint64_t>(m_next);
+    writer.write<uint64_t>(m_count);
+    writer.write<uint64_t>(m_nonzero);
+    writer.write<uint64_t>(m_sinceResync);
+    writer.write(m_sum);
+}
+
+Sma Sma::load(StateReader& reader) {
+    reader.expectTag(kSmaTag);
+    Sma sma(readWindow(reader));
+    reader.read(sma.m_values, sma.m_window);
+    sma.m_next = readIndex(reader, sma.m_window - 1);
+    sma.m_count = readIndex(reader, sma.m_window);
+    sma.m_nonzero = readIndex(reader, sma.m_count);
+    sma.m_sinceResync = readIndex(reader, sma.m_window);
+    sma.m_sum = reader.read<double>();
+    return sma;
+}
+
+RollingStd::RollingStd(size_t window) : m_window(window), m_values(window) {
+    if (window < 2) {
+        throw std::invalid_argument("Rolling standard deviation window must be at least 2");
+    }
+    reset();
+}
+
+void RollingStd::reset() {
+    m_next = 0;
+    m_count = 0;
+    m_repeats = 0;
+    m_sinceResync = 0;
+    m_mean = 0.0;
+    m_m2 = 0.0;
+}
+
+double RollingStd::update(double value) {
+    const double previous = m_count > 0 ? m_values[m_next == 0 ? m_window - 1 : m_next - 1] : 0.0;
+    
+    if (m_count < m_window) {
+        ++m_count;
+        double delta = value - m_mean;
+        m_mean += delta / static_cast<double>(m_count);
+        m_m2 += delta * (value - m_mean);
+    } else {
+        // The oldest value leaves as the new one enters
+        double leaving = m_values[m_next];
+        double oldMean = m_mean;
+        m_mean += (value - leaving) / static_cast<double>(m_window);
+        m_m2 += (value - leaving) * (value - m_mean + leaving - oldMean);
+        m_m2 = std::max(m_m2, 0.0);
+        ++m_sinceResync;
+    }
+    m_values[m_next] = value;
+    m_next = m_next + 1 == m_window ? 0 : m_next + 1;
+    
+    // A window of identical values has exactly zero deviation (as in pandas)
+    m_repeats = m_count > 1 && value == previous ? m_repeats + 1 : 1;
+    if (m_repeats >= m_count) {
+        m_mean = value;
+        m_m2 = 0.0;
+        m_sinceResync = 0;
+    } else if (m_sinceResync >= m_window) {
+        resync();
+    }
+    return this->value();
+}
+
+void RollingStd::resync() {
+    double sum = 0.0;
+    for (double value : m_values) {
+        sum += value;
+    }
+    m_mean = sum / static_cast<double>(m_window);
+    m_m2 = 0.0;
+    for (double value : m_values) {
+        m_m2 += (value - m_mean) * (value - m_mean);
+    }
+    m_sinceResync = 0;
+}
+
+double RollingStd::value() const {
+    return ready() ? std::sqrt(m_m2 / static_cast<double>(m_window - 1)) : kNaN;
+}
+
+void RollingStd::save(StateWriter& writer) const {
+    writer.write(kRollingStdTag);
+    writer.write<uint64_t>(m_window);
+    writer.write(m_values);
+    writer.write<uint64_t>(m_next);
+    writer.write<uint64_t>(m_count);
+    writer.write<uint64_t>(m_repeats);
+    writer.write<uint64_t>(m_sinceResync);
+    writer.write(m_mean);
+    writer.write(m_m2);
+}
+
+RollingStd RollingStd::load(StateReader& reader) {
+    reader.expectTag(kRollingStdTag);
+    RollingStd rolling(readWindow(reader));
+    reader.read(rolling.m_values, rolling.m_window);
+    rolling.m_next = readIndex(reader, rolling.m_window - 1);
+    rolling.m_count = readIndex(reader, rolling.m_window);
+    rolling.m_repeats = readIndex(reader, rolling.m_count);
+    rolling.m_sinceResync = readIndex(reader, rolling.m_window);
+    rolling.m_mean = reader.read<double>();
+    rolling.m_m2 = reader.read<double>();
+    return rolling;
+}
+
+void Ema::reset() {
+    m_value = 0.0;
+    m_ready = false;
+}
+
+double Ema::value() const {
+    return m_ready ? m_value : kNaN;
+}
+
+void Ema::save(StateWriter& writer) const {
+    writer.write(kEmaTag);
+    writer.write(m_span);
+    writer.write(m_value);
+    writer.write<uint8_t>(m_ready);
+}
+
+Ema Ema::load(StateReader& reader) {
+    reader.expectTag(kEmaTag);
+    Ema ema(reader.read<double>());
+    ema.m_value = reader.read<double>();
+    ema.m_ready = reader.read<uint8_t>() != 0;
+    return ema;
+}
+
+WilderRsi::WilderRsi(size_t period) : m_period(period) {
+    if (period == 0) {
+        throw std::invalid_argument("RSI period must be positive");
+    }
+    reset();
+}
+
+void WilderRsi::reset() {
+    m_changes = 0;
+    m_hasPrice = false;
+    m_lastPrice = 0.0;
+    m_avgGain = 0.0;
+    m_avgLoss = 0.0;
+}
+
+double WilderRsi::update(double price) {
+    if (!m_hasPrice) {
+        m_hasPrice = true;
+        m_lastPrice = price;
+        return kNaN;
+    }
+    
+    double change = price - m_lastPrice;
+    double gain = std::max(change, 0.0);
+    double loss = std::max(-change, 0.0);
+    m_lastPrice = price;
+    
+    if (m_changes < m_period) {
+        // Seed with the simple mean of the first `period` changes
+        m_avgGain += gain;
+        m_avgLoss += loss;
+        if (++m_changes == m_period) {
+            m_avgGain /= static_cast<double>(m_period);
+            m_avgLoss /= static_cast<double>(m_period);
+        }
+    } else {
+        const double period = static_cast<double>(m_period);
+        m_avgGain = (m_avgGain * (period - 1.0) + gain) / period;
+        m_avgLoss = (m_avgLoss * (period - 1.0) + loss) / period;
+    }
+    return value();
+}
+
+double WilderRsi::value() const {
+    if (!ready()) {
+        return kNaN;
+    }
+    if (m_avgLoss == 0.0) {
+        return m_avgGain == 0.0 ? 50.0 : 100.0;
+    }
+    return 100.0 - 100.0 / (1.0 + m_avgGain / m_avgLoss);
+}
+
+void WilderRsi::save(StateWriter& writer) const {
+    writer.write(kWilderRsiTag);
+    writer.write<uint64_t>(m_period);
+    writer.write<uint64_t>(m_changes);
+    writer.write<uint8_t>(m_hasPrice);
+    writer.write(m_lastPrice);
+    writer.write(m_avgGain);
+    writer.write(m_avgLoss);
+}
+
+WilderRsi WilderRsi::load(StateReader& reader) {
+    reader.expectTag(kWilderRsiTag);
+    WilderRsi rsi(static_cast<size_t>(reader.read<uint64_t>()));
+    rsi.m_changes = readIndex(reader, rsi.m_period);
+    rsi.m_hasPrice = reader.read<uint8_t>() != 0;
+    rsi.m_lastPrice = reader.read<double>();
+    rsi.m_avgGain = reader.read<double>();
+    rsi.m_avgLoss = reader.read<double>();
+    return rsi;
+}
+
+Macd::Macd(double fastSpan, double slowSpan, double signalSpan)
+    : m_fast(fastSpan), m_slow(slowSpan), m_signal(signalSpan) {}
+
+Macd::Macd(const Ema& fast, const Ema& slow, const Ema& signal)
+    : m_fast(fast), m_slow(slow), m_signal(signal) {}
+
+double Macd::update(double price) {
+    double macd = m_fast.update(price) - m_slow.update(price);
+    m_signal.update(macd);
+    return macd;
+}
+
+double Macd::value() const {
+    return ready() ? m_fast.value() - m_slow.value() : kNaN;
+}
+
+void Macd::reset() {
+    m_fast.reset();
+    m_slow.reset();
+    m_signal.reset();
+}
+
+void Macd::save(StateWriter& writer) const {
+    writer.write(kMacdTag);
+    m_fast.save(writer);
+    m_slow.save(writer);
+    m_signal.save(writer);
+}
+
+Macd Macd::load(StateReader& reader) {
+    reader.expectTag(kMacdTag);
+    Ema fast = Ema::load(reader);
+    Ema slow = Ema::load(reader);
+    Ema signal = Ema::load(reader);
+    return Macd(fast, slow, signal);
+}
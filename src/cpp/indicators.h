@@ -0,0 +1,351 @@
+#ifndef INDICATORS_H
+#define INDICATORS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Four-character tag that starts an indicator's saved state
+ *
+ * The last character is a layout version; bump it when the layout changes
+ * so old checkpoints are rejected instead of misread.
+ */
+constexpr uint32_t makeStateTag(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(a) | static_cast<uint32_t>(b) << 8 |
+           static_cast<uint32_t>(c) << 16 | static_cast<uint32_t>(d) << 24;
+}
+
+/**
+ * Append-only byte buffer for indicator checkpoints
+ *
+ * Values are stored in host byte order (little-endian on every platform
+ * the engine supports), so checkpoints move between processes and
+ * machines of the same architecture.
+ */
+class StateWriter {
+public:
+    template <typename T>
+    void write(T value) {
+        static_assert(std::is_trivially_copyable<T>::value, "State values must be trivially copyable");
+        m_bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    
+    void write(const std::vector<double>& values) {
+        write<uint64_t>(values.size());
+        m_bytes.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+    }
+    
+    const std::string& bytes() const { return m_bytes; }
+    
+private:
+    std::string m_bytes;
+};
+
+/**
+ * Reader over a checkpoint written by StateWriter
+ *
+ * Throws std::invalid_argument when the data is truncated or malformed.
+ */
+class StateReader {
+public:
+    StateReader(const char* data, size_t size) : m_data(data), m_size(size), m_offset(0) {}
+    
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable<T>::value, "State values must be trivially copyable");
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return value;
+    }
+    
+    void read(std::vector<double>& values, size_t expectedSize) {
+        if (read<uint64_t>() != expectedSize) {
+            throw std::invalid_argument("Indicator state has a buffer of the wrong size");
+        }
+        require(expectedSize * sizeof(double));
+        values.resize(expectedSize);
+        std::memcpy(values.data(), m_data + m_offset, expectedSize * sizeof(double));
+        m_offset += expectedSize * sizeof(double);
+    }
+    
+    /**
+     * Check the tag that starts an indicator's state
+     * 
+     * @param tag Expected tag
+     */
+    void expectTag(uint32_t tag) {
+        if (read<uint32_t>() != tag) {
+            throw std::invalid_argument("Indicator state is for a different indicator or version");
+        }
+    }
+    
+    bool done() const { return m_offset == m_size; }
+    size_t remaining() const { return m_size - m_offset; }
+    
+private:
+    void require(size_t bytes) const {
+        if (m_size - m_offset < bytes) {
+            throw std::invalid_argument("Indicator state is truncated");
+        }
+    }
+    
+    const char* m_data;
+    size_t m_size;
+    size_t m_offset;
+};
+
+/**
+ * Simple moving average over the last `window` values, O(1) per update
+ *
+ * Keeps a ring buffer and a running sum. The sum is recomputed from the
+ * buffer once per window length to bound rounding drift, and a window of
+ * zeros averages exactly zero.
+ */
+class Sma {
+public:
+    /**
+     * Constructor
+     * 
+     * @param window Number of values averaged; must be positive
+     */
+    explicit Sma(size_t window);
+    
+    /**
+     * Add the next value
+     * 
+     * @param value Value
+     * @return Current average (NaN until the window is full)
+     */
+    double update(double value);
+    
+    double value() const;
+    bool ready() const { return m_count == m_window; }
+    size_t window() const { return m_window; }
+    void reset();
+    
+    void save(StateWriter& writer) const;
+    static Sma load(StateReader& reader);
+    
+private:
+    size_t m_window;
+    std::vector<double> m_values;  // Ring buffer of the window
+    size_t m_next;                 // Slot of the next value
+    size_t m_count;
+    size_t m_nonzero;              // Nonzero values in the window
+    size_t m_sinceResync;
+    double m_sum;
+};
+
+/**
+ * Sample standard deviation over the last `window` values, O(1) per update
+ *
+ * Sliding Welford update over a ring buffer, matching pandas
+ * rolling(window).std(): a window of identical values gives exactly zero.
+ */
+class RollingStd {
+public:
+    /**
+     * Constructor
+     * 
+     * @param window Number of values; must be at least 2
+     */
+    explicit RollingStd(size_t window);
+    
+    /**
+     * Add the next value
+     * 
+     * @param value Value
+     * @return Current standard deviation (NaN until the window is full)
+     */
+    double update(double value);
+    
+    double value() const;
+    double mean() const { return m_mean; }
+    bool ready() const { return m_count == m_window; }
+    size_t window() const { return m_window; }
+    void reset();
+    
+    void save(StateWriter& writer) const;
+    static RollingStd load(StateReader& reader);
+    
+private:
+    void resync();
+    
+    size_t m_window;
+    std::vector<double> m_values;  // Ring buffer of the window
+    size_t m_next;                 // Slot of the next value
+    size_t m_count;
+    size_t m_repeats;              // Run of identical values ending at the newest
+    size_t m_sinceResync;
+    double m_mean;
+    double m_m2;
+};
+
+/**
+ * Exponential moving average with the arithmetic of pandas
+ * ewm(span=..., adjust=False).mean(), seeded with the first value
+ */
+class Ema {
+public:
+    /**
+     * Constructor
+     * 
+     * @param span Span in bars; must be at least 1
+     */
+    explicit Ema(double span)
+        : m_span(span),
+          m_newWeight(1.0 / (1.0 + (span - 1.0) / 2.0)),
+          m_oldWeight(1.0 - m_newWeight),
+          m_value(0.0),
+          m_ready(false) {
+        if (!(span >= 1.0)) {
+            throw std::invalid_argument("EMA span must be at least 1");
+        }
+    }
+    
+    double update(double value) {
+        if (!m_ready) {
+            m_ready = true;
+            m_value = value;
+        } else {
+            m_value = (m_oldWeight * m_value + m_newWeight * value) / (m_oldWeight + m_newWeight);
+        }
+        return m_value;
+    }
+    
+    double value() const;
+    bool ready() const { return m_ready; }
+    double span() const { return m_span; }
+    void reset();
+    
+    void save(StateWriter& writer) const;
+    static Ema load(StateReader& reader);
+    
+private:
+    double m_span;
+    double m_newWeight;
+    double m_oldWeight;
+    double m_value;
+    bool m_ready;
+};
+
+/**
+ * Relative Strength Index with Wilder's smoothing
+ *
+ * The first average gain and loss are the simple means of the first
+ * `period` price changes; after that each average moves by 1/period of
+ * the difference to the new change. A flat stretch (no gains and no
+ * losses) reads 50.
+ */
+class WilderRsi {
+public:
+    /**
+     * Constructor
+     * 
+     * @param period Smoothing period; must be positive
+     */
+    explicit WilderRsi(size_t period = 14);
+    
+    /**
+     * Add the next price
+     * 
+     * @param price Price
+     * @return Current RSI in [0, 100] (NaN until `period` changes are seen)
+     */
+    double update(double price);
+    
+    double value() const;
+    bool ready() const { return m_changes >= m_period; }
+    size_t period() const { return m_period; }
+    void reset();
+    
+    void save(StateWriter& writer) const;
+    static WilderRsi load(StateReader& reader);
+    
+private:
+    size_t m_period;
+    size_t m_changes;     // Price changes seen
+    bool m_hasPrice;
+    double m_lastPrice;
+    double m_avgGain;     // Sum of gains until ready, then the average
+    double m_avgLoss;     // Sum of losses until ready, then the average
+};
+
+/**
+ * MACD line, signal line and histogram from three exponential averages
+ */
+class Macd {
+public:
+    /**
+     * Constructor
+     * 
+     * @param fastSpan Span of the fast average
+     * @param slowSpan Span of the slow average
+     * @param signalSpan Span of the signal line's average of MACD
+     */
+    explicit Macd(double fastSpan = 12.0, double slowSpan = 26.0, double signalSpan = 9.0);
+    
+    /**
+     * Add the next price
+     * 
+     * @param price Price
+     * @return Current MACD (fast average - slow average)
+     */
+    double update(double price);
+    
+    double value() const;
+    double signal() const { return m_signal.value(); }
+    double histogram() const { return value() - signal(); }
+    double fast() const { return m_fast.value(); }
+    double slow() const { return m_slow.value(); }
+    bool ready() const { return m_fast.ready(); }
+    void reset();
+    
+    void save(StateWriter& writer) const;
+    static Macd load(StateReader& reader);
+    
+private:
+    Macd(const Ema& fast, const Ema& slow, const Ema& signal);
+    
+    Ema m_fast;
+    Ema m_slow;
+    Ema m_signal;
+};
+
+/**
+ * Serialize an indicator's state
+ *
+ * @param indicator Indicator (any class with save())
+ * @return Checkpoint bytes
+ */
+template <typename Indicator>
+std::string saveIndicatorState(const Indicator& indicator) {
+    StateWriter writer;
+    indicator.save(writer);
+    return writer.bytes();
+}
+
+/**
+ * Restore an indicator from a checkpoint made by saveIndicatorState
+ *
+ * @param bytes Checkpoint bytes
+ * @return Indicator in the saved state
+ */
+template <typename Indicator>
+Indicator loadIndicatorState(const std::string& bytes) {
+    StateReader reader(bytes.data(), bytes.size());
+    Indicator indicator = Indicator::load(reader);
+    if (!reader.done()) {
+        throw std::invalid_argument("Indicator state has trailing bytes");
+    }
+    return indicator;
+}
+
+#endif // INDICATORS_H
@@ -0,0 +1,46 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Read-only memory mapping of a file.
+ *
+ * The mapping is released when the object is destroyed. On platforms
+ * without mmap support open() always fails so callers can fall back to
+ * stream-based reading.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Map a file into memory
+     *
+     * @param filePath Path to the file
+     * @return True if the file was mapped, false otherwise
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * Unmap the file (no-op if nothing is mapped)
+     */
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const char* data() const { return static_cast<const char*>(m_data); }
+    size_t size() const { return m_size; }
+
+private:
+    void* m_data;
+    size_t m_size;
+};
+
+#endif // MAPPED_FILE_H
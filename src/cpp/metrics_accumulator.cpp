@@ -0,0 +1,226 @@
+#include "metrics_accumulator.h"
+#include "equity_kernels.h"
+#include <cmath>
+
+MetricsAccumulator::MetricsAccumulator()
+    : m_count(0),
+      m_mean(0.0),
+      m_m2(0.0),
+      m_downsideCount(0),
+      m_downsideSumSq(0.0),
+      m_lastReturn(0.0),
+      m_hasEquity(false),
+      m_firstEquity(0.0),
+      m_lastEquity(0.0),
+      m_peakEquity(0.0),
+      m_minEquity(0.0),
+      m_minBeforePeak(0.0),
+      m_currentDrawdown(0.0),
+      m_maxDrawdown(0.0) {}
+
+MetricsAccumulator::MetricsAccumulator(double initialEquity)
+    : MetricsAccumulator() {
+    addEquity(initialEquity);
+}
+
+void MetricsAccumulator::combineReturnMoments(size_t count, double mean, double m2) {
+    // Chan et al. pairwise update
+    size_t total = m_count + count;
+    double delta = mean - m_mean;
+    m_mean += delta * static_cast<double>(count) / static_cast<double>(total);
+    m_m2 += m2 + delta * delta * static_cast<double>(m_count) * static_cast<double>(count) / static_cast<double>(total);
+    m_count = total;
+}
+
+void MetricsAccumulator::addReturns(const double* returns, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    
+    // Independent partial sums keep several additions in flight
+    double sums[4] = {0.0, 0.0, 0.0, 0.0};
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        for (size_t k = 0; k < 4; ++k) {
+            sums[k] += returns[i + k];
+        }
+    }
+    for (; i < size; ++i) {
+        sums[0] += returns[i];
+    }
+    const double mean = ((sums[0] + sums[1]) + (sums[2] + sums[3])) / static_cast<double>(size);
+    
+    // Second pass: squared deviations and downside terms
+    double m2 = 0.0;
+    double downsideSumSq = 0.0;
+    size_t downsideCount = 0;
+    for (i = 0; i < size; ++i) {
+        const double value = returns[i];
+        const double deviation = value - mean;
+        const double downside = value < 0 ? value : 0.0;
+        m2 += deviation * deviation;
+        downsideSumSq += downside * downside;
+        downsideCount += value < 0;
+    }
+    
+    combineReturnMoments(size, mean, m2);
+    m_downsideCount += downsideCount;
+    m_downsideSumSq += downsideSumSq;
+    m_lastReturn = returns[size - 1];
+}
+
+void MetricsAccumulator::updateSeries(const double* equity, size_t size, double* drawdowns, double* returns) {
+    if (size == 0) {
+        return;
+    }
+    
+    // The first value ever seen has no return
+    if (!m_hasEquity) {
+        update(equity[0]);
+        drawdowns[0] = currentDrawdown();
+        returns[0] = lastReturn();
+        updateSeries(equity + 1, size - 1, drawdowns + 1, returns + 1);
+        return;
+    }
+    
+    // Cache-sized blocks keep the passes below from re-reading main memory
+    constexpr size_t kBlockSize = 4096;
+    for (size_t begin = 0; begin < size; begin += kBlockSize) {
+        const size_t count = std::min(kBlockSize, size - begin);
+        const double* block = equity + begin;
+        
+        computeReturns(block, count, m_lastEquity, returns + begin);
+        addReturns(returns + begin, count);
+        
+        double peak = m_peakEquity;
+        m_maxDrawdown = std::max(m_maxDrawdown, computeDrawdowns(block, count, peak, drawdowns + begin));
+        
+        // Levels needed to merge with a preceding chunk
+        double minEquity = m_minEquity;
+        double peakEquity = m_peakEquity;
+        double minBeforePeak = m_minBeforePeak;
+        for (size_t i = 0; i < count; ++i) {
+            minEquity = std::min(minEquity, block[i]);
+            if (block[i] > peakEquity) {
+                peakEquity = block[i];
+                minBeforePeak = minEquity;
+            }
+        }
+        m_minEquity = minEquity;
+        m_peakEquity = peakEquity;
+        m_minBeforePeak = minBeforePeak;
+        m_lastEquity = block[count - 1];
+    }
+    
+    m_currentDrawdown = (m_peakEquity - m_lastEquity) / m_peakEquity;
+}
+
+void MetricsAccumulator::merge(const MetricsAccumulator& next) {
+    if (!next.m_hasEquity && next.m_count == 0) {
+        return;
+    }
+    if (!m_hasEquity && m_count == 0) {
+        *this = next;
+        return;
+    }
+    
+    // Return across the chunk boundary
+    if (m_hasEquity && next.m_hasEquity) {
+        addReturn(next.m_firstEquity / m_lastEquity - 1.0);
+    }
+    
+    // Combine return moments
+    if (next.m_count > 0) {
+        combineReturnMoments(next.m_count, next.m_mean, next.m_m2);
+        m_downsideCount += next.m_downsideCount;
+        m_downsideSumSq += next.m_downsideSumSq;
+        m_lastReturn = next.m_lastReturn;
+    }
+    
+    if (!next.m_hasEquity) {
+        return;
+    }
+    if (!m_hasEquity) {
+        m_hasEquity = true;
+        m_firstEquity = next.m_firstEquity;
+        m_lastEquity = next.m_lastEquity;
+        m_peakEquity = next.m_peakEquity;
+        m_minEquity = next.m_minEquity;
+        m_minBeforePeak = next.m_minBeforePeak;
+        m_currentDrawdown = next.m_currentDrawdown;
+        m_maxDrawdown = next.m_maxDrawdown;
+        return;
+    }
+    
+    // Until the next chunk first exceeds our peak its running peak is ours,
+    // so its deepest point relative to our peak is its minimum over that
+    // stretch. Points between the first exceedance and its own peak are
+    // already covered by its internal drawdown.
+    double crossMin = next.m_peakEquity > m_peakEquity ? next.m_minBeforePeak : next.m_minEquity;
+    double crossDrawdown = (m_peakEquity - crossMin) / m_peakEquity;
+    m_maxDrawdown = std::max({m_maxDrawdown, next.m_maxDrawdown, crossDrawdown});
+    
+    if (next.m_peakEquity > m_peakEquity) {
+        m_minBeforePeak = std::min(m_minEquity, next.m_minBeforePeak);
+        m_peakEquity = next.m_peakEquity;
+        m_currentDrawdown = next.m_currentDrawdown;
+    } else {
+        m_currentDrawdown = (m_peakEquity - next.m_lastEquity) / m_peakEquity;
+    }
+    m_minEquity = std::min(m_minEquity, next.m_minEquity);
+    m_lastEquity = next.m_lastEquity;
+}
+
+double MetricsAccumulator::variance() const {
+    return m_count > 0 ? m_m2 / static_cast<double>(m_count) : 0.0;
+}
+
+double MetricsAccumulator::downsideDeviation() const {
+    return m_downsideCount > 0 ? std::sqrt(m_downsideSumSq / static_cast<double>(m_downsideCount)) : 0.0;
+}
+
+double MetricsAccumulator::sharpeRatio(double riskFreeRate) const {
+    double stdDev = std::sqrt(variance());
+    
+    // Avoid division by zero
+    if (stdDev == 0.0) {
+        return 0.0;
+    }
+    
+    // Annualize (assuming 252 trading days)
+    return (m_mean - riskFreeRate / 252.0) / stdDev * std::sqrt(252.0);
+}
+
+double MetricsAccumulator::sortinoRatio(double riskFreeRate) const {
+    double downside = downsideDeviation();
+    
+    // Avoid division by zero
+    if (downside == 0.0) {
+        return 0.0;
+    }
+    
+    // Annualize (assuming 252 trading days)
+    return (m_mean - riskFreeRate / 252.0) / downside * std::sqrt(252.0);
+}
+
+PerformanceStats MetricsAccumulator::stats(double initialCapital, double riskFreeRate) const {
+    PerformanceStats stats;
+    
+    if (!m_hasEquity || m_count == 0) {
+        return stats;
+    }
+    
+    stats.totalReturn = (m_lastEquity / initialCapital - 1.0) * 100.0;
+    stats.maxDrawdown = maxDrawdown();
+    stats.sharpeRatio = sharpeRatio(riskFreeRate);
+    stats.sortinoRatio = sortinoRatio(riskFreeRate);
+    
+    // Calculate annualized return
+    double years = static_cast<double>(m_count) / 252.0;
+    if (years > 0) {
+        stats.annualizedReturn = std::pow(1.0 + stats.totalReturn / 100.0, 1.0 / years) - 1.0;
+        stats.annualizedReturn *= 100.0;
+    }
+    
+    return stats;
+}
@@ -0,0 +1,208 @@
+#ifndef METRICS_ACCUMULATOR_H
+#define METRICS_ACCUMULATOR_H
+
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * Structure to hold performance statistics
+ */
+struct PerformanceStats {
+    double totalReturn = 0.0;
+    double annualizedReturn = 0.0;
+    double maxDrawdown = 0.0;
+    double sharpeRatio = 0.0;
+    double sortinoRatio = 0.0;
+};
+
+/**
+ * Single-pass, mergeable accumulator for performance metrics
+ *
+ * Tracks return moments (Welford), downside deviation, drawdown and equity
+ * levels in O(1) per observation, so metrics can be maintained inside the
+ * backtest loop instead of in separate passes. Accumulators built over
+ * consecutive chunks of an equity curve with update() can be merged in
+ * time order for parallel reduction; the result is exact, including the
+ * drawdown across the chunk boundary.
+ */
+class MetricsAccumulator {
+public:
+    /**
+     * Create an empty accumulator
+     */
+    MetricsAccumulator();
+    
+    /**
+     * Create an accumulator seeded with a starting equity (e.g. initial capital)
+     * 
+     * @param initialEquity Starting equity; the first return is measured from it
+     */
+    explicit MetricsAccumulator(double initialEquity);
+    
+    /**
+     * Add the next equity value and the return from the previous value
+     * 
+     * @param equity Equity value
+     */
+    void update(double equity) {
+        if (m_hasEquity) {
+            addReturn(equity / m_lastEquity - 1.0);
+        }
+        addEquity(equity);
+    }
+    
+    /**
+     * Add an equity value (levels and drawdown only)
+     * 
+     * @param equity Equity value
+     */
+    void addEquity(double equity) {
+        if (!m_hasEquity) {
+            m_hasEquity = true;
+            m_firstEquity = equity;
+            m_peakEquity = equity;
+            m_minEquity = equity;
+            m_minBeforePeak = equity;
+        }
+        
+        m_minEquity = std::min(m_minEquity, equity);
+        if (equity > m_peakEquity) {
+            m_peakEquity = equity;
+            m_minBeforePeak = m_minEquity;
+        }
+        
+        m_currentDrawdown = (m_peakEquity - equity) / m_peakEquity;
+        m_maxDrawdown = std::max(m_maxDrawdown, m_currentDrawdown);
+        m_lastEquity = equity;
+    }
+    
+    /**
+     * Add a return (moments and downside deviation only)
+     * 
+     * @param value Simple return
+     */
+    void addReturn(double value) {
+        ++m_count;
+        double delta = value - m_mean;
+        m_mean += delta / static_cast<double>(m_count);
+        m_m2 += delta * (value - m_mean);
+        
+        if (value < 0) {
+            ++m_downsideCount;
+            m_downsideSumSq += value * value;
+        }
+        m_lastReturn = value;
+    }
+    
+    /**
+     * Add a block of returns (moments and downside deviation only)
+     * 
+     * Equivalent to addReturn() for each value; the block's moments are
+     * computed in two passes and combined with the running ones.
+     * 
+     * @param returns Simple returns
+     * @param size Number of returns
+     */
+    void addReturns(const double* returns, size_t size);
+    
+    /**
+     * Add a block of consecutive equity values
+     * 
+     * Equivalent to calling update() for each value and reading
+     * currentDrawdown() and lastReturn() after each, but runs the drawdown
+     * and return arithmetic through the vectorized equity kernels.
+     * 
+     * @param equity Equity values
+     * @param size Number of values
+     * @param drawdowns Output drawdown percentage per value
+     * @param returns Output simple return per value
+     */
+    void updateSeries(const double* equity, size_t size, double* drawdowns, double* returns);
+    
+    /**
+     * Merge an accumulator covering the chunk that directly follows this one
+     * 
+     * Both accumulators must have been built with update(). The return
+     * between this chunk's last equity and the next chunk's first equity is
+     * added.
+     * 
+     * @param next Accumulator for the following chunk
+     */
+    void merge(const MetricsAccumulator& next);
+    
+    size_t count() const { return m_count; }
+    double mean() const { return m_mean; }
+    double lastReturn() const { return m_lastReturn; }
+    double firstEquity() const { return m_firstEquity; }
+    double lastEquity() const { return m_lastEquity; }
+    double peakEquity() const { return m_peakEquity; }
+    
+    /**
+     * Population variance of returns
+     */
+    double variance() const;
+    
+    /**
+     * Root mean square of negative returns
+     */
+    double downsideDeviation() const;
+    
+    /**
+     * Drawdown of the last equity value from its running peak, in percent
+     */
+    double currentDrawdown() const { return m_currentDrawdown * 100.0; }
+    
+    /**
+     * Maximum drawdown, in percent
+     */
+    double maxDrawdown() const { return m_maxDrawdown * 100.0; }
+    
+    /**
+     * Annualized Sharpe ratio (assuming daily returns)
+     * 
+     * @param riskFreeRate Annual risk-free rate (e.g., 0.02 for 2%)
+     */
+    double sharpeRatio(double riskFreeRate = 0.0) const;
+    
+    /**
+     * Annualized Sortino ratio (assuming daily returns)
+     * 
+     * @param riskFreeRate Annual risk-free rate (e.g., 0.02 for 2%)
+     */
+    double sortinoRatio(double riskFreeRate = 0.0) const;
+    
+    /**
+     * Build PerformanceStats from the accumulated values
+     * 
+     * @param initialCapital Initial capital
+     * @param riskFreeRate Annual risk-free rate (e.g., 0.02 for 2%)
+     * @return PerformanceStats structure
+     */
+    PerformanceStats stats(double initialCapital, double riskFreeRate = 0.0) const;
+    
+private:
+    /**
+     * Combine the moments of another set of returns into the running ones
+     */
+    void combineReturnMoments(size_t count, double mean, double m2);
+    
+    // Return moments
+    size_t m_count;
+    double m_mean;
+    double m_m2;
+    size_t m_downsideCount;
+    double m_downsideSumSq;
+    double m_lastReturn;
+    
+    // Equity levels and drawdown (drawdowns stored as fractions)
+    bool m_hasEquity;
+    double m_firstEquity;
+    double m_lastEquity;
+    double m_peakEquity;
+    double m_minEquity;
+    double m_minBeforePeak;  // Lowest equity up to the first occurrence of the peak
+    double m_currentDrawdown;
+    double m_maxDrawdown;
+};
+
+#endif // METRICS_ACCUMULATOR_H
@@ -0,0 +1,86 @@
+#include "parameter_sweep.h"
+#include "thread_pool.h"
+#include "timestamp.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+
+ParameterSweep::ParameterSweep(const SignalFrame& signals)
+    : m_signals(signals) {}
+
+std::vector<SweepConfig> ParameterSweep::makeGrid(
+    const std::vector<double>& initialCapitals,
+    const std::vector<double>& slippages,
+    const std::vector<double>& latencies
+) {
+    std::vector<SweepConfig> configs;
+    configs.reserve(initialCapitals.size() * slippages.size() * latencies.size());
+    
+    for (double initialCapital : initialCapitals) {
+        for (double slippage : slippages) {
+            for (double latency : latencies) {
+                configs.push_back({initialCapital, slippage, latency});
+            }
+        }
+    }
+    
+    return configs;
+}
+
+std::vector<BacktestResults> ParameterSweep::run(const std::vector<SweepConfig>& configs, size_t numThreads,
+                                                ArenaStats* arenaStats) const {
+    std::vector<BacktestResults> results(configs.size());
+    if (configs.empty() || m_signals.empty()) {
+        return results;
+    }
+    
+    ThreadPool pool(std::min(numThreads == 0 ? std::thread::hardware_concurrency() : numThreads, configs.size()));
+    
+    // Latencies used by more than one configuration get a shared fill table
+    std::map<int64_t, size_t> latencyUses;
+    for (const SweepConfig& config : configs) {
+        ++latencyUses[secondsToNanos(config.latency)];
+    }
+    std::vector<int64_t> sharedLatencies;
+    for (const auto& entry : latencyUses) {
+        if (entry.first > 0 && entry.second > 1) {
+            sharedLatencies.push_back(entry.first);
+        }
+    }
+    std::vector<std::shared_ptr<const std::vector<size_t>>> tables(sharedLatencies.size());
+    pool.parallelFor(sharedLatencies.size(), [&](size_t i) {
+        tables[i] = std::make_shared<const std::vector<size_t>>(m_signals.forwardIndex(sharedLatencies[i]));
+    });
+    
+    // One arena per worker; a run's buffers are released in O(1) when it ends
+    std::vector<RunArena> arenas(pool.size());
+    pool.parallelForSlots(configs.size(), [&](size_t i, size_t slot) {
+        const SweepConfig& config = configs[i];
+        RunArena& arena = arenas[slot];
+        {
+            // Each run gets its own account state; the frame columns are shared
+            Backtester backtester(config.initialCapital, config.slippage, config.latency, &arena);
+            backtester.setSignals(m_signals);
+            const int64_t latency = secondsToNanos(config.latency);
+            auto shared = std::lower_bound(sharedLatencies.begin(), sharedLatencies.end(), latency);
+            if (shared != sharedLatencies.end() && *shared == latency) {
+                backtester.setFillIndex(tables[shared - sharedLatencies.begin()]);
+            }
+            backtester.runBacktest();
+            results[i] = backtester.getResults();
+        }
+        arena.reset();
+    });
+    
+    if (arenaStats != nullptr) {
+        *arenaStats = ArenaStats();
+        for (const RunArena& arena : arenas) {
+            arenaStats->add(arena.stats());
+        }
+    }
+    return results;
+}
+
+const SignalFrame& ParameterSweep::getSignals() const {
+    return m_signals;
+}
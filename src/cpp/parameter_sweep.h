@@ -0,0 +1,77 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <cstddef>
+#include <vector>
+#include "backtester.h"  // For BacktestResults and SignalFrame
+#include "run_arena.h"   // For ArenaStats
+
+/**
+ * One backtest configuration in a sweep
+ */
+struct SweepConfig {
+    double initialCapital = 10000.0;
+    double slippage = 0.0005;
+    double latency = 0.0;
+};
+
+/**
+ * ParameterSweep class for running many backtest configurations over the
+ * same signals in parallel
+ *
+ * The signals are loaded once and shared read-only by all workers.
+ */
+class ParameterSweep {
+public:
+    /**
+     * Constructor
+     * 
+     * @param signals Signal frame shared by every configuration
+     */
+    explicit ParameterSweep(const SignalFrame& signals);
+    
+    /**
+     * Build the cartesian product of parameter values
+     * 
+     * Configurations are ordered with latency varying fastest, then
+     * slippage, then initial capital.
+     * 
+     * @param initialCapitals Initial capital values
+     * @param slippages Slippage values
+     * @param latencies Latency values in seconds
+     * @return Vector of configurations
+     */
+    static std::vector<SweepConfig> makeGrid(
+        const std::vector<double>& initialCapitals,
+        const std::vector<double>& slippages,
+        const std::vector<double>& latencies
+    );
+    
+    /**
+     * Run every configuration
+     * 
+     * A latency shared by several configurations has its fill-row table
+     * (SignalFrame::forwardIndex) built once and reused by each of them.
+     * Each worker allocates its runs' buffers from its own RunArena, so
+     * after a worker's first run the loop no longer touches the heap.
+     * 
+     * @param configs Configurations to run
+     * @param numThreads Number of worker threads (0 = one per hardware thread)
+     * @param arenaStats Optional output: the workers' arena counters, summed
+     * @return Results in the same order as configs
+     */
+    std::vector<BacktestResults> run(const std::vector<SweepConfig>& configs, size_t numThreads = 0,
+                                     ArenaStats* arenaStats = nullptr) const;
+    
+    /**
+     * Get the shared signals
+     * 
+     * @return Signal frame
+     */
+    const SignalFrame& getSignals() const;
+    
+private:
+    SignalFrame m_signals;
+};
+
+#endif // PARAMETER_SWEEP_H
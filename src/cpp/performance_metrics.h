@@ -2,18 +2,8 @@
 #define PERFORMANCE_METRICS_H
 
 #include <vector>
-#include "backtester.h"  // For EquityPoint structure
-
-/**
- * Structure to hold performance statistics
- */
-struct PerformanceStats {
-    double totalReturn = 0.0;
-    double annualizedReturn = 0.0;
-    double maxDrawdown = 0.0;
-    double sharpeRatio = 0.0;
-    double sortinoRatio = 0.0;
-};
+#include "backtester.h"  // For EquityPoint and SignalFrame structures
+#include "metrics_accumulator.h"
 
 /**
  * PerformanceMetrics class for calculating performance metrics
@@ -29,6 +19,23 @@ public:
      */
     static double calculateTotalReturn(const std::vector<EquityPoint>& equity, double initialCapital);
     
+    /**
+     * Calculate total return
+     * 
+     * @param equityValues Vector of equity values
+     * @param initialCapital Initial capital
+     * @return Total return percentage
+     */
+    static double calculateTotalReturn(const std::vector<double>& equityValues, double initialCapital);
+    
+    /**
+     * Calculate the buy-and-hold return of the underlying over a signal frame
+     * 
+     * @param signals Signal frame
+     * @return Buy-and-hold return percentage
+     */
+    static double calculateBuyAndHoldReturn(const SignalFrame& signals);
+    
     /**
      * Calculate maximum drawdown
      * 
@@ -70,6 +77,22 @@ public:
         double initialCapital,
         double riskFreeRate = 0.0
     );
+    
+    /**
+     * Calculate all performance metrics from columnar equity values
+     * 
+     * @param equityValues Vector of equity values
+     * @param returns Vector of returns
+     * @param initialCapital Initial capital
+     * @param riskFreeRate Annual risk-free rate (e.g., 0.02 for 2%)
+     * @return PerformanceStats structure
+     */
+    static PerformanceStats calculateAllMetrics(
+        const std::vector<double>& equityValues,
+        const std::vector<double>& returns,
+        double initialCapital,
+        double riskFreeRate = 0.0
+    );
 };
 
 #endif // PERFORMANCE_METRICS_H
\ No newline at end of file
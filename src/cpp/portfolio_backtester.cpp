@@ -0,0 +1,229 @@
+#include "portfolio_backtester.h"
+#include "timestamp.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+// Number of symbols whose signal differs from the current one
+size_t countChanges(const int8_t* signals, const int8_t* current, size_t numSymbols) {
+    size_t changes = 0;
+    for (size_t s = 0; s < numSymbols; ++s) {
+        changes += signals[s] != current[s];
+    }
+    return changes;
+}
+
+// Sum of every sleeve's cash plus the value of its position
+double markToMarket(const double* cash, const int* positions, const double* prices, size_t numSymbols) {
+    // Independent partial sums let the compiler keep several lanes in flight
+    // (flat sleeves skip the price so NaN prices of unlisted symbols are harmless)
+    double sums[4] = {0.0, 0.0, 0.0, 0.0};
+    size_t s = 0;
+    for (; s + 4 <= numSymbols; s += 4) {
+        for (size_t k = 0; k < 4; ++k) {
+            sums[k] += cash[s + k] + (positions[s + k] > 0 ? positions[s + k] * prices[s + k] : 0.0);
+        }
+    }
+    for (; s < numSymbols; ++s) {
+        sums[0] += cash[s] + (positions[s] > 0 ? positions[s] * prices[s] : 0.0);
+    }
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+} // namespace
+
+PortfolioBacktester::PortfolioBacktester()
+    : m_initialCapital(10000.0),
+      m_slippage(0.0005),
+      m_latency(0.0) {}
+
+PortfolioBacktester::PortfolioBacktester(double initialCapital, double slippage, double latency)
+    : m_initialCapital(initialCapital),
+      m_slippage(slippage),
+      m_latency(latency) {}
+
+void PortfolioBacktester::setPanel(const SignalPanel& panel) {
+    m_panel = panel;
+    m_weights.clear();
+    m_equity.clear();
+    m_drawdowns.clear();
+    m_returns.clear();
+    m_trades.clear();
+}
+
+const SignalPanel& PortfolioBacktester::getPanel() const {
+    return m_panel;
+}
+
+void PortfolioBacktester::setWeights(const std::vector<double>& weights) {
+    if (weights.size() != m_panel.numSymbols()) {
+        throw std::invalid_argument("Expected one weight per panel symbol");
+    }
+    
+    double total = 0.0;
+    for (double weight : weights) {
+        if (!(weight >= 0.0)) {
+            throw std::invalid_argument("Weights must be non-negative");
+        }
+        total += weight;
+    }
+    if (!(total > 0.0)) {
+        throw std::invalid_argument("Weights must sum to a positive value");
+    }
+    
+    m_weights.resize(weights.size());
+    for (size_t s = 0; s < weights.size(); ++s) {
+        m_weights[s] = weights[s] / total;
+    }
+}
+
+void PortfolioBacktester::runBacktest() {
+    if (m_panel.empty()) {
+        std::cerr << "Error: No signals loaded" << std::endl;
+        return;
+    }
+    
+    const size_t numTimes = m_panel.numTimes();
+    const size_t numSymbols = m_panel.numSymbols();
+    const int64_t* timestamps = m_panel.timestamps();
+    
+    // Allocate the capital into one sleeve per symbol
+    m_cash.resize(numSymbols);
+    for (size_t s = 0; s < numSymbols; ++s) {
+        m_cash[s] = m_initialCapital * (m_weights.empty() ? 1.0 / numSymbols : m_weights[s]);
+    }
+    m_positions.assign(numSymbols, 0);
+    m_currentSignals.assign(numSymbols, 0);
+    m_metrics = MetricsAccumulator(m_initialCapital);
+    
+    // Size every output buffer once so the loop never allocates
+    m_equity.resize(numTimes);
+    m_drawdowns.resize(numTimes);
+    m_returns.resize(numTimes);
+    
+    // Every trade needs a signal change, so this bounds the trade count
+    size_t signalChanges = 0;
+    for (size_t t = 0; t < numTimes; ++t) {
+        signalChanges += countChanges(m_panel.signalsAt(t), t == 0 ? m_currentSignals.data() : m_panel.signalsAt(t - 1), numSymbols);
+    }
+    m_trades.clear();
+    m_trades.reserve(signalChanges);
+    
+    ExecutionEngine<ProportionalSlippage, NoLatency, AllInSizing> engine(ProportionalSlippage{m_slippage});
+    const int64_t latencyNanos = secondsToNanos(m_latency);
+    size_t fillCursor = 0;
+    
+    double* cash = m_cash.data();
+    int* positions = m_positions.data();
+    int8_t* currentSignals = m_currentSignals.data();
+    
+    // Drawdown and return statistics are fed one block of timestamps at a
+    // time, while that block's equity is still in cache
+    constexpr size_t kMetricsBlock = 4096;
+    size_t metricsBegin = 0;
+    
+    for (size_t t = 0; t < numTimes; ++t) {
+        const double* prices = m_panel.pricesAt(t);
+        const int8_t* signals = m_panel.signalsAt(t);
+        
+        // Quiet cross-sections skip straight to the mark-to-market
+        if (countChanges(signals, currentSignals, numSymbols) != 0) {
+            // Every symbol shares the timestamps, so the fill row is found once
+            size_t fillRow = t;
+            if (latencyNanos > 0) {
+                fillCursor = seekTimestamp(timestamps, numTimes, timestamps[t] + latencyNanos, std::max(fillCursor, t));
+                fillRow = std::min(fillCursor, numTimes - 1);
+            }
+            const double* fillPrices = m_panel.pricesAt(fillRow);
+            
+            for (size_t s = 0; s < numSymbols; ++s) {
+                if (signals[s] == currentSignals[s]) {
+                    continue;
+                }
+                
+                Account account{cash[s], positions[s]};
+                engine.execute(account, signals[s], fillPrices[s], timestamps[t], [&](const TradeRecord& trade) {
+                    m_trades.push_back({static_cast<uint32_t>(s), trade});
+                });
+                cash[s] = account.cash;
+                positions[s] = account.position;
+                currentSignals[s] = signals[s];
+            }
+        }
+        
+        // Record aggregate equity
+        m_equity[t] = markToMarket(cash, positions, prices, numSymbols);
+        
+        if (t + 1 - metricsBegin == kMetricsBlock || t + 1 == numTimes) {
+            m_metrics.updateSeries(m_equity.data() + metricsBegin, t + 1 - metricsBegin,
+                                   m_drawdowns.data() + metricsBegin, m_returns.data() + metricsBegin);
+            metricsBegin = t + 1;
+        }
+    }
+}
+
+BacktestResults PortfolioBacktester::getResults() const {
+    BacktestResults results;
+    
+    if (m_equity.empty() || m_metrics.count() == 0) {
+        return results;
+    }
+    
+    results.finalEquity = m_metrics.lastEquity();
+    results.finalReturn = (results.finalEquity / m_initialCapital - 1.0) * 100.0;
+    results.maxDrawdown = m_metrics.maxDrawdown();
+    
+    // Annualized Sharpe ratio (assuming daily returns)
+    results.sharpeRatio = m_metrics.sharpeRatio();
+    
+    // Trading statistics
+    results.totalTrades = m_trades.size();
+    
+    return results;
+}
+
+const std::vector<double>& PortfolioBacktester::getEquity() const {
+    return m_equity;
+}
+
+const std::vector<double>& PortfolioBacktester::getDrawdowns() const {
+    return m_drawdowns;
+}
+
+const std::vector<double>& PortfolioBacktester::getReturns() const {
+    return m_returns;
+}
+
+std::vector<double> PortfolioBacktester::getSymbolEquity() const {
+    std::vector<double> equity(m_cash.size());
+    if (m_cash.empty() || m_panel.empty()) {
+        return equity;
+    }
+    
+    const double* lastPrices = m_panel.pricesAt(m_panel.numTimes() - 1);
+    for (size_t s = 0; s < m_cash.size(); ++s) {
+        equity[s] = Account{m_cash[s], m_positions[s]}.equity(lastPrices[s]);
+    }
+    return equity;
+}
+
+const std::vector<PortfolioFill>& PortfolioBacktester::getTrades() const {
+    return m_trades;
+}
+
+PortfolioSeries PortfolioBacktester::releaseSeries() {
+    PortfolioSeries series;
+    series.symbolEquity = getSymbolEquity();
+    series.equity = std::move(m_equity);
+    series.drawdowns = std::move(m_drawdowns);
+    series.returns = std::move(m_returns);
+    series.trades = std::move(m_trades);
+    
+    m_equity.clear();
+    m_drawdowns.clear();
+    m_returns.clear();
+    m_trades.clear();
+    return series;
+}
@@ -0,0 +1,165 @@
+#ifndef PORTFOLIO_BACKTESTER_H
+#define PORTFOLIO_BACKTESTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "backtester.h"  // For BacktestResults
+#include "execution_engine.h"
+#include "metrics_accumulator.h"
+#include "signal_panel.h"
+
+/**
+ * Trade in one symbol of a portfolio
+ */
+struct PortfolioFill {
+    uint32_t symbol;    // Column of the symbol in the panel
+    TradeRecord fill;
+};
+
+/**
+ * Structure to hold the per-timestamp output series of a portfolio backtest
+ */
+struct PortfolioSeries {
+    std::vector<double> equity;        // Aggregate equity per timestamp
+    std::vector<double> drawdowns;     // Drawdown percentage per timestamp
+    std::vector<double> returns;       // Simple return per timestamp
+    std::vector<double> symbolEquity;  // Final equity of each symbol's sleeve
+    std::vector<PortfolioFill> trades;
+};
+
+/**
+ * PortfolioBacktester class for running one strategy across many symbols
+ *
+ * Capital is split into one sleeve per symbol (equally, or by weight), and
+ * each sleeve trades its symbol's signals the way Backtester trades a single
+ * series, through the same ExecutionEngine. Cash and positions live in flat
+ * per-symbol arrays. Each timestamp's cross-section is processed in
+ * unit-stride loops, and aggregate equity, drawdown and return statistics
+ * are accumulated in the same pass, one cache-sized block of timestamps at a
+ * time.
+ */
+class PortfolioBacktester {
+public:
+    /**
+     * Default constructor
+     */
+    PortfolioBacktester();
+    
+    /**
+     * Constructor with parameters
+     * 
+     * @param initialCapital Initial capital for the whole portfolio
+     * @param slippage Slippage parameter (0.001 = 0.1%)
+     * @param latency Latency in seconds; orders fill at the first timestamp at
+     *                or after the signal change plus the latency
+     */
+    PortfolioBacktester(double initialCapital, double slippage, double latency);
+    
+    /**
+     * Use a signal panel
+     * 
+     * The panel's columns are shared, not copied. Any capital weights are
+     * reset to equal weights.
+     * 
+     * @param panel Signal panel
+     */
+    void setPanel(const SignalPanel& panel);
+    
+    /**
+     * Get the loaded panel
+     * 
+     * @return Signal panel
+     */
+    const SignalPanel& getPanel() const;
+    
+    /**
+     * Allocate the initial capital across symbols in proportion to weights
+     * 
+     * @param weights One non-negative weight per panel symbol
+     * @throws std::invalid_argument if the weights do not match the panel or
+     *         do not sum to a positive value
+     */
+    void setWeights(const std::vector<double>& weights);
+    
+    /**
+     * Run the backtest over every timestamp of the panel
+     * 
+     * A symbol's price may be NaN (e.g. before it lists) only while its
+     * sleeve is flat and its signal is 0.
+     */
+    void runBacktest();
+    
+    /**
+     * Get the aggregate backtest results
+     * 
+     * @return BacktestResults structure
+     */
+    BacktestResults getResults() const;
+    
+    /**
+     * Get the aggregate equity for each timestamp
+     * 
+     * @return Vector of equity values
+     */
+    const std::vector<double>& getEquity() const;
+    
+    /**
+     * Get the drawdown percentage of the aggregate equity for each timestamp
+     * 
+     * @return Vector of drawdowns
+     */
+    const std::vector<double>& getDrawdowns() const;
+    
+    /**
+     * Get the simple return of the aggregate equity for each timestamp
+     * 
+     * @return Vector of returns
+     */
+    const std::vector<double>& getReturns() const;
+    
+    /**
+     * Get the final equity of each symbol's sleeve
+     * 
+     * @return Vector with one value per panel symbol
+     */
+    std::vector<double> getSymbolEquity() const;
+    
+    /**
+     * Get the executed trades in time order
+     * 
+     * @return Vector of trades tagged with their symbol
+     */
+    const std::vector<PortfolioFill>& getTrades() const;
+    
+    /**
+     * Move the output series out of the backtester without copying
+     * 
+     * The backtester's series are left empty until the next runBacktest.
+     * 
+     * @return PortfolioSeries structure
+     */
+    PortfolioSeries releaseSeries();
+    
+private:
+    double m_initialCapital;
+    double m_slippage;
+    double m_latency;
+    
+    SignalPanel m_panel;
+    std::vector<double> m_weights;  // Capital fraction per symbol (empty = equal)
+    
+    // Per-symbol account state, indexed by panel column
+    std::vector<double> m_cash;
+    std::vector<int> m_positions;
+    std::vector<int8_t> m_currentSignals;
+    
+    std::vector<double> m_equity;
+    std::vector<double> m_drawdowns;
+    std::vector<double> m_returns;
+    std::vector<PortfolioFill> m_trades;
+    
+    MetricsAccumulator m_metrics;  // Updated per block in the backtest loop
+};
+
+#endif // PORTFOLIO_BACKTESTER_H
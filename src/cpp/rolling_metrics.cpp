@@ -0,0 +1,223 @@
+#include "rolling_metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Periods per year used to annualize (assuming daily returns)
+constexpr double kPeriodsPerYear = 252.0;
+
+} // namespace
+
+RollingMetrics::RollingMetrics(size_t window, double riskFreeRate)
+    : m_window(window),
+      m_riskFreeRate(riskFreeRate) {
+    if (window == 0) {
+        throw std::invalid_argument("Rolling window must be positive");
+    }
+    m_returns.resize(window);
+    m_peakValues.resize(window);
+    m_peakBars.resize(window);
+    reset();
+}
+
+void RollingMetrics::reset() {
+    m_next = 0;
+    m_count = 0;
+    m_sinceResync = 0;
+    m_mean = 0.0;
+    m_m2 = 0.0;
+    m_downsideSumSq = 0.0;
+    m_downsideCount = 0;
+    m_lastReturn = 0.0;
+    m_repeats = 0;
+    
+    m_peakHead = 0;
+    m_peakSize = 0;
+    m_bars = 0;
+    m_lastEquity = 0.0;
+}
+
+void RollingMetrics::update(double equity) {
+    if (m_bars > 0) {
+        addReturn(equity / m_lastEquity - 1.0);
+    }
+    addEquity(equity);
+}
+
+void RollingMetrics::addReturn(double value) {
+    if (m_count < m_window) {
+        // Growing window: plain Welford update
+        ++m_count;
+        double delta = value - m_mean;
+        m_mean += delta / static_cast<double>(m_count);
+        m_m2 += delta * (value - m_mean);
+    } else {
+        // Full window: the oldest return leaves as the new one enters
+        double leaving = m_returns[m_next];
+        double oldMean = m_mean;
+        m_mean += (value - leaving) / static_cast<double>(m_count);
+        m_m2 += (value - leaving) * (value - m_mean + leaving - oldMean);
+        m_m2 = std::max(m_m2, 0.0);
+        
+        if (leaving < 0.0) {
+            --m_downsideCount;
+            m_downsideSumSq -= leaving * leaving;
+        }
+        ++m_sinceResync;
+    }
+    
+    if (value < 0.0) {
+        ++m_downsideCount;
+        m_downsideSumSq += value * value;
+    }
+    if (m_downsideCount == 0) {
+        m_downsideSumSq = 0.0;
+    }
+    m_downsideSumSq = std::max(m_downsideSumSq, 0.0);
+    
+    m_returns[m_next] = value;
+    m_next = m_next + 1 == m_window ? 0 : m_next + 1;
+    
+    // A window of identical returns (e.g. a flat position) has exactly zero
+    // variance; pin it so rounding residue cannot produce a huge ratio
+    m_repeats = (m_count > 1 && value == m_lastReturn) ? m_repeats + 1 : 1;
+    m_lastReturn = value;
+    if (m_repeats >= m_count) {
+        m_mean = value;
+        m_m2 = 0.0;
+        m_downsideSumSq = value < 0.0 ? static_cast<double>(m_count) * value * value : 0.0;
+        m_sinceResync = 0;
+    } else if (m_sinceResync >= m_window) {
+        // Once per window length, so still O(1) per bar amortized
+        resync();
+    }
+}
+
+void RollingMetrics::resync() {
+    double sum = 0.0;
+    for (size_t i = 0; i < m_count; ++i) {
+        sum += m_returns[i];
+    }
+    m_mean = sum / static_cast<double>(m_count);
+    
+    m_m2 = 0.0;
+    m_downsideSumSq = 0.0;
+    for (size_t i = 0; i < m_count; ++i) {
+        double value = m_returns[i];
+        m_m2 += (value - m_mean) * (value - m_mean);
+        if (value < 0.0) {
+            m_downsideSumSq += value * value;
+        }
+    }
+    m_sinceResync = 0;
+}
+
+void RollingMetrics::addEquity(double equity) {
+    // Drop the peak candidate that has left the window
+    if (m_peakSize > 0 && m_peakBars[m_peakHead] + m_window <= m_bars) {
+        m_peakHead = m_peakHead + 1 == m_window ? 0 : m_peakHead + 1;
+        --m_peakSize;
+    }
+    
+    // Values no larger than the new one can never be the peak again
+    while (m_peakSize > 0) {
+        size_t back = m_peakHead + m_peakSize - 1;
+        back -= back >= m_window ? m_window : 0;
+        if (m_peakValues[back] > equity) {
+            break;
+        }
+        --m_peakSize;
+    }
+    
+    size_t slot = m_peakHead + m_peakSize;
+    slot -= slot >= m_window ? m_window : 0;
+    m_peakValues[slot] = equity;
+    m_peakBars[slot] = m_bars;
+    ++m_peakSize;
+    
+    ++m_bars;
+    m_lastEquity = equity;
+}
+
+double RollingMetrics::volatility() const {
+    if (!full()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return std::sqrt(m_m2 / static_cast<double>(m_count)) * std::sqrt(kPeriodsPerYear);
+}
+
+double RollingMetrics::sharpeRatio() const {
+    if (!full()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    double stdDev = std::sqrt(m_m2 / static_cast<double>(m_count));
+    
+    // Avoid division by zero
+    if (stdDev == 0.0) {
+        return 0.0;
+    }
+    return (m_mean - m_riskFreeRate / kPeriodsPerYear) / stdDev * std::sqrt(kPeriodsPerYear);
+}
+
+double RollingMetrics::sortinoRatio() const {
+    if (!full()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    double downside = m_downsideCount > 0
+        ? std::sqrt(m_downsideSumSq / static_cast<double>(m_downsideCount))
+        : 0.0;
+    
+    // Avoid division by zero
+    if (downside == 0.0) {
+        return 0.0;
+    }
+    return (m_mean - m_riskFreeRate / kPeriodsPerYear) / downside * std::sqrt(kPeriodsPerYear);
+}
+
+double RollingMetrics::drawdown() const {
+    if (m_peakSize == 0) {
+        return 0.0;
+    }
+    double peak = m_peakValues[m_peakHead];
+    return (peak - m_lastEquity) / peak * 100.0;
+}
+
+void RollingMetrics::compute(const double* equity, size_t size, const RollingOutputs& outputs) {
+    reset();
+    for (size_t i = 0; i < size; ++i) {
+        update(equity[i]);
+        if (outputs.volatility != nullptr) {
+            outputs.volatility[i] = volatility();
+        }
+        if (outputs.sharpe != nullptr) {
+            outputs.sharpe[i] = sharpeRatio();
+        }
+        if (outputs.sortino != nullptr) {
+            outputs.sortino[i] = sortinoRatio();
+        }
+        if (outputs.drawdown != nullptr) {
+            outputs.drawdown[i] = drawdown();
+        }
+    }
+}
+
+std::vector<RollingSeries> computeRollingMetrics(const double* equity,
+                                                 size_t size,
+                                                 const std::vector<size_t>& windows,
+                                                 double riskFreeRate) {
+    std::vector<RollingSeries> series(windows.size());
+    for (size_t w = 0; w < windows.size(); ++w) {
+        RollingMetrics metrics(windows[w], riskFreeRate);
+        RollingSeries& out = series[w];
+        out.window = windows[w];
+        out.volatility.resize(size);
+        out.sharpe.resize(size);
+        out.sortino.resize(size);
+        out.drawdown.resize(size);
+        metrics.compute(equity, size, {out.volatility.data(), out.sharpe.data(), out.sortino.data(), out.drawdown.data()});
+    }
+    return series;
+}
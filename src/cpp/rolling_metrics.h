@@ -0,0 +1,152 @@
+#ifndef ROLLING_METRICS_H
+#define ROLLING_METRICS_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Output columns of RollingMetrics::compute, one value per bar
+ *
+ * Any pointer may be null to skip that column.
+ */
+struct RollingOutputs {
+    double* volatility = nullptr;  // Annualized standard deviation of returns
+    double* sharpe = nullptr;      // Annualized Sharpe ratio
+    double* sortino = nullptr;     // Annualized Sortino ratio
+    double* drawdown = nullptr;    // Drawdown from the window's peak equity, in percent
+};
+
+/**
+ * Rolling-window performance metrics over an equity curve in O(1) per bar
+ *
+ * Return moments are kept over a ring buffer of the last `window` returns
+ * with a sliding Welford update (the leaving return is removed as the new
+ * one is added), and the window's peak equity is kept in a monotonic deque,
+ * so each bar costs the same whatever the window length. The ratios use
+ * the same definitions as MetricsAccumulator (population variance, 252
+ * periods per year), restricted to the window.
+ *
+ * Volatility, Sharpe and Sortino are NaN until the window holds `window`
+ * returns (i.e. for the first `window` bars); drawdown is measured over the
+ * bars seen so far until `window` of them are available.
+ */
+class RollingMetrics {
+public:
+    /**
+     * Constructor
+     * 
+     * @param window Number of returns (and equity values) in the window; must be positive
+     * @param riskFreeRate Annual risk-free rate (e.g., 0.02 for 2%)
+     */
+    explicit RollingMetrics(size_t window, double riskFreeRate = 0.0);
+    
+    /**
+     * Forget all bars, keeping the window and risk-free rate
+     */
+    void reset();
+    
+    /**
+     * Add the next equity value and the return from the previous value
+     * 
+     * @param equity Equity value
+     */
+    void update(double equity);
+    
+    /**
+     * Run over a whole equity curve from a reset state
+     * 
+     * @param equity Equity values
+     * @param size Number of values
+     * @param outputs Columns to fill, each with room for size values
+     */
+    void compute(const double* equity, size_t size, const RollingOutputs& outputs);
+    
+    size_t window() const { return m_window; }
+    
+    /**
+     * Check whether the window holds `window` returns
+     * 
+     * @return True once the ratios are defined
+     */
+    bool full() const { return m_count == m_window; }
+    
+    /**
+     * Annualized standard deviation of the window's returns (NaN until full)
+     */
+    double volatility() const;
+    
+    /**
+     * Annualized Sharpe ratio of the window's returns (NaN until full)
+     */
+    double sharpeRatio() const;
+    
+    /**
+     * Annualized Sortino ratio of the window's returns (NaN until full)
+     */
+    double sortinoRatio() const;
+    
+    /**
+     * Drawdown of the last equity value from the window's peak, in percent
+     */
+    double drawdown() const;
+    
+private:
+    /**
+     * Recompute the moments and downside sum from the ring buffer, discarding
+     * the rounding error accumulated by the sliding updates
+     */
+    void resync();
+    
+    void addReturn(double value);
+    void addEquity(double equity);
+    
+    size_t m_window;
+    double m_riskFreeRate;
+    
+    // Returns in the window (ring buffer)
+    std::vector<double> m_returns;
+    size_t m_next;               // Slot of the next return
+    size_t m_count;              // Returns in the window
+    size_t m_sinceResync;        // Sliding updates since the last resync
+    double m_mean;
+    double m_m2;
+    double m_downsideSumSq;
+    size_t m_downsideCount;
+    double m_lastReturn;
+    size_t m_repeats;            // Length of the run of identical returns ending at the newest
+    
+    // Equity values that can still be the window's peak, decreasing (ring buffer)
+    std::vector<double> m_peakValues;
+    std::vector<size_t> m_peakBars;
+    size_t m_peakHead;
+    size_t m_peakSize;
+    size_t m_bars;               // Equity values seen
+    double m_lastEquity;
+};
+
+/**
+ * Rolling metrics of one window length for a whole equity curve
+ */
+struct RollingSeries {
+    size_t window = 0;
+    std::vector<double> volatility;
+    std::vector<double> sharpe;
+    std::vector<double> sortino;
+    std::vector<double> drawdown;
+};
+
+/**
+ * Compute rolling metrics for several window lengths
+ *
+ * @param equity Equity values
+ * @param size Number of values
+ * @param windows Window lengths (e.g. 20, 60, 252)
+ * @param riskFreeRate Annual risk-free rate (e.g., 0.02 for 2%)
+ * @return One series per window, in the same order
+ */
+std::vector<RollingSeries> computeRollingMetrics(const double* equity,
+                                                 size_t size,
+                                                 const std::vector<size_t>& windows,
+                                                 double riskFreeRate = 0.0);
+
+#endif // ROLLING_METRICS_H
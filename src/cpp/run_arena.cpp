@@ -0,0 +1,103 @@
+#include "run_arena.h"
+#include <algorithm>
+#include <new>
+
+namespace {
+
+// Alignment of the arena's own buffer
+constexpr size_t kBufferAlignment = alignof(std::max_align_t);
+
+} // namespace
+
+void ArenaStats::add(const ArenaStats& other) {
+    capacity = std::max(capacity, other.capacity);
+    bytesInUse += other.bytesInUse;
+    highWater = std::max(highWater, other.highWater);
+    allocations += other.allocations;
+    heapAllocations += other.heapAllocations;
+    resets += other.resets;
+}
+
+void* RunArena::HeapResource::do_allocate(size_t bytes, size_t alignment) {
+    ++m_stats.heapAllocations;
+    return ::operator new(bytes, std::align_val_t(alignment));
+}
+
+void RunArena::HeapResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    ::operator delete(p, bytes, std::align_val_t(alignment));
+}
+
+bool RunArena::HeapResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+RunArena::RunArena(size_t initialCapacity)
+    : m_heap(m_stats),
+      m_buffer(nullptr),
+      m_footprint(0),
+      m_heapAllocationsAtReset(0) {
+    if (initialCapacity > 0) {
+        m_buffer = m_heap.allocate(initialCapacity, kBufferAlignment);
+        m_stats.capacity = initialCapacity;
+        m_monotonic.emplace(m_buffer, m_stats.capacity, &m_heap);
+    } else {
+        m_monotonic.emplace(&m_heap);
+    }
+    m_heapAllocationsAtReset = m_stats.heapAllocations;
+}
+
+RunArena::~RunArena() {
+    m_monotonic.reset();
+    if (m_buffer != nullptr) {
+        m_heap.deallocate(m_buffer, m_stats.capacity, kBufferAlignment);
+    }
+}
+
+void RunArena::reset() {
+    const bool spilled = m_stats.heapAllocations != m_heapAllocationsAtReset;
+    
+    // Hands any spilled chunks back to the heap
+    m_monotonic.reset();
+    
+    // Replace the buffer with one that holds the whole of the last run
+    if (spilled) {
+        if (m_buffer != nullptr) {
+            m_heap.deallocate(m_buffer, m_stats.capacity, kBufferAlignment);
+        }
+        m_stats.capacity = std::max(m_footprint, m_stats.capacity);
+        m_buffer = m_heap.allocate(m_stats.capacity, kBufferAlignment);
+    }
+    
+    if (m_buffer != nullptr) {
+        m_monotonic.emplace(m_buffer, m_stats.capacity, &m_heap);
+    } else {
+        m_monotonic.emplace(&m_heap);
+    }
+    m_footprint = 0;
+    m_stats.bytesInUse = 0;
+    ++m_stats.resets;
+    m_heapAllocationsAtReset = m_stats.heapAllocations;
+}
+
+const ArenaStats& RunArena::stats() const {
+    return m_stats;
+}
+
+void* RunArena::do_allocate(size_t bytes, size_t alignment) {
+    void* p = m_monotonic->allocate(bytes, alignment);
+    
+    ++m_stats.allocations;
+    m_stats.bytesInUse += bytes;
+    m_stats.highWater = std::max(m_stats.highWater, m_stats.bytesInUse);
+    // Worst-case alignment padding, so the regrown buffer always fits
+    m_footprint += bytes + alignment;
+    return p;
+}
+
+void RunArena::do_deallocate(void*, size_t, size_t) {
+    // Memory is reclaimed all at once by reset()
+}
+
+bool RunArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
@@ -0,0 +1,97 @@
+#ifndef RUN_ARENA_H
+#define RUN_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+
+/**
+ * Allocation counters of a RunArena
+ */
+struct ArenaStats {
+    size_t capacity = 0;         // Bytes in the arena's own buffer
+    size_t bytesInUse = 0;       // Bytes handed out since the last reset
+    size_t highWater = 0;        // Most bytes handed out between two resets
+    size_t allocations = 0;      // Allocations served by the arena
+    size_t heapAllocations = 0;  // Allocations that reached the global heap
+    size_t resets = 0;           // Number of reset() calls
+    
+    /**
+     * Add another arena's counters (high water and capacity take the larger)
+     * 
+     * @param other Counters to add
+     */
+    void add(const ArenaStats& other);
+};
+
+/**
+ * Monotonic arena for the buffers of one backtest run at a time
+ *
+ * Allocations bump a pointer through one owned buffer and deallocation is
+ * a no-op; reset() makes the whole buffer available again in O(1). A run
+ * that outgrows the buffer spills into heap chunks, and the next reset()
+ * replaces the buffer with one large enough for it, so a stream of similar
+ * runs stops touching the global heap after the first.
+ *
+ * Everything allocated from the arena must be destroyed before reset().
+ * Not thread-safe: use one arena per worker thread.
+ */
+class RunArena : public std::pmr::memory_resource {
+public:
+    /**
+     * Constructor
+     * 
+     * @param initialCapacity Size of the first buffer in bytes (0 = allocate on first use)
+     */
+    explicit RunArena(size_t initialCapacity = 0);
+    
+    ~RunArena() override;
+    
+    RunArena(const RunArena&) = delete;
+    RunArena& operator=(const RunArena&) = delete;
+    
+    /**
+     * Release everything allocated since the last reset
+     * 
+     * Grows the buffer first if the last run spilled onto the heap.
+     */
+    void reset();
+    
+    /**
+     * Get the allocation counters
+     * 
+     * @return Counters since construction (bytesInUse since the last reset)
+     */
+    const ArenaStats& stats() const;
+    
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    
+private:
+    /**
+     * Upstream of the monotonic resource: the global heap, counted
+     */
+    class HeapResource : public std::pmr::memory_resource {
+    public:
+        explicit HeapResource(ArenaStats& stats) : m_stats(stats) {}
+        
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+        
+    private:
+        ArenaStats& m_stats;
+    };
+    
+    ArenaStats m_stats;
+    HeapResource m_heap;
+    void* m_buffer;
+    size_t m_footprint;             // Bytes this run would need, padding included
+    size_t m_heapAllocationsAtReset;
+    std::optional<std::pmr::monotonic_buffer_resource> m_monotonic;
+};
+
+#endif // RUN_ARENA_H
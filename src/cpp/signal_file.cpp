@@ -0,0 +1,172 @@
+#include "signal_file.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const char kMagic[8] = {'S', 'Q', 'S', 'I', 'G', 'N', 'A', 'L'};
+
+const char* const kTimestampColumn = "timestamp";
+const char* const kPriceColumn = "price";
+const char* const kSignalColumn = "signal";
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Locate a column block and validate its type and bounds
+const char* findColumn(const char* data, size_t size, const SignalFileHeader& header,
+                       const char* name, uint32_t dtype, uint32_t itemSize, size_t alignment) {
+    for (uint32_t c = 0; c < header.columnCount; ++c) {
+        SignalFileColumn column;
+        std::memcpy(&column, data + sizeof(SignalFileHeader) + c * sizeof(SignalFileColumn), sizeof(column));
+        if (std::strncmp(column.name, name, sizeof(column.name)) != 0) {
+            continue;
+        }
+        if (column.dtype != dtype || column.itemSize != itemSize) {
+            std::cerr << "Error: Column '" << name << "' has an unexpected type" << std::endl;
+            return nullptr;
+        }
+        if (column.offset % alignment != 0 || column.offset > size ||
+            header.rowCount > (size - column.offset) / itemSize) {
+            std::cerr << "Error: Column '" << name << "' is out of bounds or misaligned" << std::endl;
+            return nullptr;
+        }
+        return data + column.offset;
+    }
+    std::cerr << "Error: Missing column '" << name << "'" << std::endl;
+    return nullptr;
+}
+
+} // namespace
+
+bool SignalFile::hasMagic(const char* data, size_t size) {
+    return size >= sizeof(kMagic) && std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool SignalFile::isSignalFile(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    char magic[sizeof(kMagic)];
+    if (!file.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return hasMagic(magic, sizeof(magic));
+}
+
+bool SignalFile::read(const std::string& filePath, SignalFrame& frame, std::string* symbol) {
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(filePath)) {
+        std::cerr << "Error: Could not map file " << filePath << std::endl;
+        return false;
+    }
+    
+    const char* data = file->data();
+    const size_t size = file->size();
+    
+    if (size < sizeof(SignalFileHeader) || !hasMagic(data, size)) {
+        std::cerr << "Error: " << filePath << " is not a signal file" << std::endl;
+        return false;
+    }
+    
+    SignalFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    
+    if (header.version != kVersion) {
+        std::cerr << "Error: Unsupported signal file version " << header.version << std::endl;
+        return false;
+    }
+    if (header.columnCount > (size - sizeof(SignalFileHeader)) / sizeof(SignalFileColumn) ||
+        header.headerSize < sizeof(SignalFileHeader) + header.columnCount * sizeof(SignalFileColumn) ||
+        header.headerSize > size) {
+        std::cerr << "Error: Corrupt signal file header in " << filePath << std::endl;
+        return false;
+    }
+    
+    const char* timestamps = findColumn(data, size, header, kTimestampColumn, kSignalFileInt64, sizeof(int64_t), alignof(int64_t));
+    const char* prices = findColumn(data, size, header, kPriceColumn, kSignalFileFloat64, sizeof(double), alignof(double));
+    const char* signals = findColumn(data, size, header, kSignalColumn, kSignalFileInt8, sizeof(int8_t), alignof(int8_t));
+    if (timestamps == nullptr || prices == nullptr || signals == nullptr) {
+        return false;
+    }
+    
+    if (symbol != nullptr) {
+        symbol->assign(header.symbol, strnlen(header.symbol, sizeof(header.symbol)));
+    }
+    
+    // The frame keeps the mapping alive
+    frame = SignalFrame(static_cast<size_t>(header.rowCount),
+                        reinterpret_cast<const int64_t*>(timestamps),
+                        reinterpret_cast<const double*>(prices),
+                        reinterpret_cast<const int8_t*>(signals),
+                        std::move(file));
+    return true;
+}
+
+bool SignalFile::write(const std::string& filePath, const SignalFrame& frame, const std::string& symbol) {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filePath << std::endl;
+        return false;
+    }
+    
+    const uint64_t rows = frame.size();
+    const uint32_t columnCount = 3;
+    
+    SignalFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.headerSize = sizeof(SignalFileHeader) + columnCount * sizeof(SignalFileColumn);
+    header.rowCount = rows;
+    std::memcpy(header.symbol, symbol.data(), std::min(symbol.size(), sizeof(header.symbol) - 1));
+    header.columnCount = columnCount;
+    header.alignment = kAlignment;
+    
+    struct Block {
+        const char* name;
+        uint32_t dtype;
+        uint32_t itemSize;
+        const void* data;
+    };
+    const Block blocks[columnCount] = {
+        {kTimestampColumn, kSignalFileInt64, sizeof(int64_t), frame.timestamps()},
+        {kPriceColumn, kSignalFileFloat64, sizeof(double), frame.prices()},
+        {kSignalColumn, kSignalFileInt8, sizeof(int8_t), frame.signals()},
+    };
+    
+    // Lay out the column blocks
+    SignalFileColumn columns[columnCount];
+    uint64_t offset = alignUp(header.headerSize, kAlignment);
+    for (uint32_t c = 0; c < columnCount; ++c) {
+        std::memset(&columns[c], 0, sizeof(SignalFileColumn));
+        std::strncpy(columns[c].name, blocks[c].name, sizeof(columns[c].name) - 1);
+        columns[c].dtype = blocks[c].dtype;
+        columns[c].itemSize = blocks[c].itemSize;
+        columns[c].offset = offset;
+        offset = alignUp(offset + rows * blocks[c].itemSize, kAlignment);
+    }
+    
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(columns), sizeof(columns));
+    
+    const std::vector<char> padding(kAlignment, 0);
+    uint64_t position = header.headerSize;
+    for (uint32_t c = 0; c < columnCount; ++c) {
+        file.write(padding.data(), static_cast<std::streamsize>(columns[c].offset - position));
+        if (rows > 0) {
+            file.write(static_cast<const char*>(blocks[c].data), static_cast<std::streamsize>(rows * blocks[c].itemSize));
+        }
+        position = columns[c].offset + rows * blocks[c].itemSize;
+    }
+    
+    if (!file) {
+        std::cerr << "Error: Failed writing " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,99 @@
+#ifndef SIGNAL_FILE_H
+#define SIGNAL_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "signal_frame.h"
+
+/**
+ * Binary columnar signal file (little-endian)
+ *
+ * Layout:
+ *   SignalFileHeader                      (64 bytes)
+ *   SignalFileColumn[columnCount]         (32 bytes each)
+ *   column blocks, each starting at a multiple of `alignment` bytes
+ *
+ * Version 1 stores three columns: "timestamp" (int64 nanoseconds since the
+ * Unix epoch), "price" (float64) and "signal" (int8). Readers locate columns
+ * by name through the column table, so extra columns are ignored.
+ */
+struct SignalFileHeader {
+    char magic[8];          // "SQSIGNAL"
+    uint32_t version;       // Format version
+    uint32_t headerSize;    // Header plus column table, in bytes
+    uint64_t rowCount;      // Rows per column
+    char symbol[32];        // NUL-padded ticker symbol
+    uint32_t columnCount;   // Entries in the column table
+    uint32_t alignment;     // Column block alignment in bytes
+};
+
+/**
+ * Entry in the column table
+ */
+struct SignalFileColumn {
+    char name[16];          // NUL-padded column name
+    uint32_t dtype;         // SignalFileDType
+    uint32_t itemSize;      // Bytes per value
+    uint64_t offset;        // Byte offset of the column block from the start of the file
+};
+
+static_assert(sizeof(SignalFileHeader) == 64, "SignalFileHeader layout changed");
+static_assert(sizeof(SignalFileColumn) == 32, "SignalFileColumn layout changed");
+
+enum SignalFileDType : uint32_t {
+    kSignalFileInt64 = 1,
+    kSignalFileFloat64 = 2,
+    kSignalFileInt8 = 3
+};
+
+/**
+ * Reader and writer for binary signal files
+ */
+class SignalFile {
+public:
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kAlignment = 64;
+    
+    /**
+     * Check whether a buffer starts with the signal file magic bytes
+     * 
+     * @param data Start of the buffer
+     * @param size Size of the buffer in bytes
+     * @return True if the magic bytes match
+     */
+    static bool hasMagic(const char* data, size_t size);
+    
+    /**
+     * Check whether a file is a binary signal file (by its magic bytes)
+     * 
+     * @param filePath Path to the file
+     * @return True if the file starts with the magic bytes
+     */
+    static bool isSignalFile(const std::string& filePath);
+    
+    /**
+     * Memory-map a signal file and expose its columns as a frame
+     * 
+     * The returned frame points straight into the mapping, which stays
+     * alive as long as the frame (or a copy of it) does.
+     * 
+     * @param filePath Path to the file
+     * @param frame Loaded frame (only written on success)
+     * @param symbol Optional output for the symbol stored in the header
+     * @return True if successful, false otherwise
+     */
+    static bool read(const std::string& filePath, SignalFrame& frame, std::string* symbol = nullptr);
+    
+    /**
+     * Write a frame as a signal file
+     * 
+     * @param filePath Path to the file
+     * @param frame Signal frame
+     * @param symbol Ticker symbol (truncated to 31 bytes)
+     * @return True if successful, false otherwise
+     */
+    static bool write(const std::string& filePath, const SignalFrame& frame, const std::string& symbol);
+};
+
+#endif // SIGNAL_FILE_H
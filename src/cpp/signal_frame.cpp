@@ -0,0 +1,110 @@
+#include "signal_frame.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+struct OwnedColumns {
+    std::vector<int64_t> timestamps;
+    std::vector<double> prices;
+    std::vector<int8_t> signals;
+};
+
+} // namespace
+
+size_t seekTimestamp(const int64_t* timestamps, size_t size, int64_t time, size_t from) {
+    if (from >= size || timestamps[from] >= time) {
+        return std::min(from, size);
+    }
+    
+    // Gallop until the bracket (low, high] holds the answer
+    size_t low = from;
+    size_t step = 1;
+    size_t high = from + step;
+    while (high < size && timestamps[high] < time) {
+        low = high;
+        step *= 2;
+        high = low + step;
+    }
+    high = std::min(high, size);
+    
+    return static_cast<size_t>(std::lower_bound(timestamps + low + 1, timestamps + high, time) - timestamps);
+}
+
+SignalFrame::SignalFrame()
+    : m_timestamps(nullptr),
+      m_prices(nullptr),
+      m_signals(nullptr),
+      m_size(0) {}
+
+SignalFrame::SignalFrame(std::vector<int64_t> timestamps, std::vector<double> prices, std::vector<int8_t> signals)
+    : SignalFrame() {
+    if (timestamps.size() != prices.size() || prices.size() != signals.size()) {
+        throw std::invalid_argument("SignalFrame columns must have the same length");
+    }
+    
+    auto columns = std::make_shared<OwnedColumns>();
+    columns->timestamps = std::move(timestamps);
+    columns->prices = std::move(prices);
+    columns->signals = std::move(signals);
+    
+    m_timestamps = columns->timestamps.data();
+    m_prices = columns->prices.data();
+    m_signals = columns->signals.data();
+    m_size = columns->prices.size();
+    m_owner = std::move(columns);
+}
+
+SignalFrame::SignalFrame(size_t size, const int64_t* timestamps, const double* prices, const int8_t* signals,
+                         std::shared_ptr<const void> owner)
+    : m_owner(std::move(owner)),
+      m_timestamps(timestamps),
+      m_prices(prices),
+      m_signals(signals),
+      m_size(size) {}
+
+SignalFrame SignalFrame::fromSignals(const std::vector<Signal>& signals) {
+    std::vector<int64_t> timestamps;
+    std::vector<double> prices;
+    std::vector<int8_t> values;
+    timestamps.reserve(signals.size());
+    prices.reserve(signals.size());
+    values.reserve(signals.size());
+    
+    for (const auto& signal : signals) {
+        timestamps.push_back(signal.timestamp);
+        prices.push_back(signal.price);
+        values.push_back(static_cast<int8_t>(signal.signal));
+    }
+    
+    return SignalFrame(std::move(timestamps), std::move(prices), std::move(values));
+}
+
+std::vector<size_t> SignalFrame::forwardIndex(int64_t delay) const {
+    std::vector<size_t> fillRows(m_size);
+    
+    // Target times only move forward, so the fill row does too
+    size_t fillRow = 0;
+    for (size_t i = 0; i < m_size; ++i) {
+        const int64_t target = m_timestamps[i] + delay;
+        fillRow = std::max(fillRow, i);
+        while (fillRow < m_size - 1 && m_timestamps[fillRow] < target) {
+            ++fillRow;
+        }
+        fillRows[i] = fillRow;
+    }
+    return fillRows;
+}
+
+Signal SignalFrame::at(size_t i) const {
+    return {m_timestamps[i], m_prices[i], m_signals[i]};
+}
+
+std::vector<Signal> SignalFrame::toSignals() const {
+    std::vector<Signal> signals;
+    signals.reserve(m_size);
+    for (size_t i = 0; i < m_size; ++i) {
+        signals.push_back(at(i));
+    }
+    return signals;
+}
@@ -0,0 +1,137 @@
+#ifndef SIGNAL_FRAME_H
+#define SIGNAL_FRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Structure to hold signal data from CSV
+ *
+ * Row-oriented view of a SignalFrame row, kept for compatibility.
+ */
+struct Signal {
+    int64_t timestamp;  // Nanoseconds since the Unix epoch
+    double price;
+    int signal;  // 0 = no position/sell, 1 = buy
+};
+
+/**
+ * Find the first index at or after a time in a sorted timestamp column
+ * 
+ * Gallops forward from `from` and then binary-searches the bracket, so it
+ * costs O(log d) where d is the distance to the result.
+ * 
+ * @param timestamps Non-decreasing timestamps in nanoseconds since the epoch
+ * @param size Number of timestamps
+ * @param time Time to find
+ * @param from First index to consider
+ * @return First index >= from with timestamp >= time, or size if none
+ */
+size_t seekTimestamp(const int64_t* timestamps, size_t size, int64_t time, size_t from);
+
+/**
+ * Columnar (structure-of-arrays) signal store
+ *
+ * Timestamps (nanoseconds since the Unix epoch), prices and signals are
+ * held in separate contiguous arrays so the backtest loop only streams the
+ * columns it reads. A frame is immutable once built and copies share the
+ * same column storage, so copying is O(1).
+ */
+class SignalFrame {
+public:
+    /**
+     * Create an empty frame
+     */
+    SignalFrame();
+    
+    /**
+     * Create a frame that takes ownership of the given columns
+     * 
+     * @param timestamps Timestamps in nanoseconds since the Unix epoch
+     * @param prices Prices
+     * @param signals Signals (0 = no position/sell, 1 = buy)
+     * @throws std::invalid_argument if the columns differ in length
+     */
+    SignalFrame(std::vector<int64_t> timestamps, std::vector<double> prices, std::vector<int8_t> signals);
+    
+    /**
+     * Create a frame over externally owned columns without copying
+     * 
+     * @param size Number of rows
+     * @param timestamps Timestamp column
+     * @param prices Price column
+     * @param signals Signal column
+     * @param owner Keeps the column memory alive for the lifetime of the frame
+     *              and all of its copies (e.g. a memory mapping)
+     */
+    SignalFrame(size_t size, const int64_t* timestamps, const double* prices, const int8_t* signals,
+                std::shared_ptr<const void> owner);
+    
+    /**
+     * Build a frame from row-oriented signals
+     * 
+     * @param signals Vector of signals
+     * @return SignalFrame
+     */
+    static SignalFrame fromSignals(const std::vector<Signal>& signals);
+    
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    
+    const int64_t* timestamps() const { return m_timestamps; }
+    const double* prices() const { return m_prices; }
+    const int8_t* signals() const { return m_signals; }
+    
+    int64_t timestamp(size_t i) const { return m_timestamps[i]; }
+    double price(size_t i) const { return m_prices[i]; }
+    int signal(size_t i) const { return m_signals[i]; }
+    
+    /**
+     * Find the first row at or after a time, searching forward from a row
+     * 
+     * Timestamps must be non-decreasing (see seekTimestamp).
+     * 
+     * @param time Time in nanoseconds since the Unix epoch
+     * @param from First row to consider
+     * @return First row >= from with timestamp >= time, or size() if none
+     */
+    size_t seek(int64_t time, size_t from = 0) const { return seekTimestamp(m_timestamps, m_size, time, from); }
+    
+    /**
+     * Build a table of the row each row's order fills at after a delay
+     * 
+     * Entry i is the first row whose timestamp is at or after
+     * timestamp(i) + delay, or the last row if there is none. Built in one
+     * forward pass; lets runs that share a latency skip the searches.
+     * 
+     * @param delay Delay in nanoseconds
+     * @return Fill row for every row
+     */
+    std::vector<size_t> forwardIndex(int64_t delay) const;
+    
+    /**
+     * Row view of the frame
+     * 
+     * @param i Row index
+     * @return Signal
+     */
+    Signal at(size_t i) const;
+    
+    /**
+     * Convert the frame to row-oriented signals
+     * 
+     * @return Vector of signals
+     */
+    std::vector<Signal> toSignals() const;
+    
+private:
+    std::shared_ptr<const void> m_owner;  // Keeps the column storage alive
+    const int64_t* m_timestamps;
+    const double* m_prices;
+    const int8_t* m_signals;
+    size_t m_size;
+};
+
+#endif // SIGNAL_FRAME_H
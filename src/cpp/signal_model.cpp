@@ -0,0 +1,270 @@
+#include "signal_model.h"
+#include "indicator_engine.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const char kMagic[8] = {'S', 'Q', 'M', 'O', 'D', 'E', 'L', '\0'};
+
+// Rows scored together; each tree is walked for the whole block while its
+// nodes are in cache, and the block's inputs (256 rows of a dozen values)
+// stay in L1
+constexpr size_t kBlockRows = 256;
+
+// Sequential reader over the blocks that follow the header
+class BlockReader {
+public:
+    BlockReader(const char* data, size_t size) : m_data(data), m_size(size), m_offset(sizeof(ModelFileHeader)) {}
+    
+    template <typename T>
+    bool read(std::vector<T>& values, uint64_t count) {
+        if (count > (m_size - m_offset) / sizeof(T)) {
+            return false;
+        }
+        values.resize(static_cast<size_t>(count));
+        std::memcpy(values.data(), m_data + m_offset, values.size() * sizeof(T));
+        m_offset += values.size() * sizeof(T);
+        return true;
+    }
+    
+    bool done() const { return m_offset == m_size; }
+    
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_offset;
+};
+
+bool allFinite(const std::vector<double>& values) {
+    return std::all_of(values.begin(), values.end(), [](double value) { return std::isfinite(value); });
+}
+
+// Check that the trees are stored one after another, each a well-formed
+// preorder layout: every node lies inside its parent's range and is reached
+// exactly once, so any walk moves forward and ends at a leaf
+bool validTrees(const std::vector<uint64_t>& roots, const std::vector<ModelNode>& nodes, size_t featureCount) {
+    struct Range {
+        size_t node;
+        size_t end;  // One past the last node of the subtree
+    };
+    std::vector<Range> stack;
+    
+    // Each tree's range ends at the next root, so every root must lie inside
+    // the node array, in increasing order, before any tree is walked
+    if (roots.empty() || roots[0] != 0) {
+        return false;
+    }
+    for (size_t t = 0; t < roots.size(); ++t) {
+        if (roots[t] >= nodes.size() || (t > 0 && roots[t] <= roots[t - 1])) {
+            return false;
+        }
+    }
+    
+    for (size_t t = 0; t < roots.size(); ++t) {
+        const size_t end = t + 1 < roots.size() ? static_cast<size_t>(roots[t + 1]) : nodes.size();
+        stack.push_back({static_cast<size_t>(roots[t]), end});
+        while (!stack.empty()) {
+            const Range range = stack.back();
+            stack.pop_back();
+            const ModelNode& node = nodes[range.node];
+            if (!std::isfinite(node.value)) {
+                return false;
+            }
+            if (node.feature == -1) {
+                if (range.node + 1 != range.end) {
+                    return false;
+                }
+                continue;
+            }
+            const size_t right = static_cast<size_t>(node.right);
+            if (node.feature < 0 || static_cast<size_t>(node.feature) >= featureCount ||
+                node.right <= 0 || right <= range.node + 1 || right >= range.end) {
+                return false;
+            }
+            stack.push_back({right, range.end});
+            stack.push_back({range.node + 1, right});
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+SignalModel::SignalModel() : m_kind(kModelLinear), m_classes{0, 1}, m_intercept(0.0) {}
+
+bool SignalModel::load(const std::string& filePath, SignalModel& model) {
+    MappedFile file;
+    if (!file.open(filePath)) {
+        std::cerr << "Error: Could not map file " << filePath << std::endl;
+        return false;
+    }
+    
+    const char* data = file.data();
+    const size_t size = file.size();
+    
+    if (size < sizeof(ModelFileHeader) || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+        std::cerr << "Error: " << filePath << " is not a model file" << std::endl;
+        return false;
+    }
+    
+    ModelFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    
+    if (header.version != kVersion) {
+        std::cerr << "Error: Unsupported model file version " << header.version << std::endl;
+        return false;
+    }
+    if (header.kind != kModelLinear && header.kind != kModelTreeEnsemble) {
+        std::cerr << "Error: Unknown model kind " << header.kind << std::endl;
+        return false;
+    }
+    for (int32_t label : header.classes) {
+        if (label < std::numeric_limits<int8_t>::min() || label > std::numeric_limits<int8_t>::max()) {
+            std::cerr << "Error: Model class " << label << " does not fit a signal" << std::endl;
+            return false;
+        }
+    }
+    
+    SignalModel loaded;
+    loaded.m_kind = static_cast<ModelKind>(header.kind);
+    loaded.m_classes[0] = static_cast<int8_t>(header.classes[0]);
+    loaded.m_classes[1] = static_cast<int8_t>(header.classes[1]);
+    
+    BlockReader reader(data, size);
+    bool valid = header.featureCount > 0 &&
+                 reader.read(loaded.m_columns, header.featureCount) &&
+                 reader.read(loaded.m_mean, header.featureCount) &&
+                 reader.read(loaded.m_scale, header.featureCount);
+    if (valid && loaded.m_kind == kModelLinear) {
+        std::vector<double> intercept;
+        valid = header.treeCount == 0 && header.nodeCount == 0 &&
+                reader.read(loaded.m_coefficients, header.featureCount) &&
+                reader.read(intercept, 1) &&
+                allFinite(loaded.m_coefficients) && std::isfinite(intercept[0]);
+        if (valid) {
+            loaded.m_intercept = intercept[0];
+        }
+    } else if (valid) {
+        // Node links are int32
+        valid = header.treeCount > 0 &&
+                header.nodeCount <= static_cast<uint64_t>(std::numeric_limits<int32_t>::max()) &&
+                reader.read(loaded.m_roots, header.treeCount) &&
+                reader.read(loaded.m_nodes, header.nodeCount) &&
+                validTrees(loaded.m_roots, loaded.m_nodes, loaded.featureCount());
+    }
+    valid = valid && reader.done() && allFinite(loaded.m_mean) && allFinite(loaded.m_scale) &&
+            std::none_of(loaded.m_scale.begin(), loaded.m_scale.end(), [](double scale) { return scale == 0.0; });
+    if (!valid) {
+        std::cerr << "Error: Corrupt model file " << filePath << std::endl;
+        return false;
+    }
+    
+    model = std::move(loaded);
+    return true;
+}
+
+size_t SignalModel::requiredColumns() const {
+    return m_columns.empty() ? 0 : *std::max_element(m_columns.begin(), m_columns.end()) + size_t{1};
+}
+
+void SignalModel::standardize(const double* features, size_t rows, size_t rowStride, double* inputs) const {
+    const size_t featureCount = m_columns.size();
+    for (size_t r = 0; r < rows; ++r) {
+        const double* row = features + r * rowStride;
+        double* input = inputs + r * featureCount;
+        for (size_t f = 0; f < featureCount; ++f) {
+            input[f] = (row[m_columns[f]] - m_mean[f]) / m_scale[f];
+        }
+        if (m_kind == kModelTreeEnsemble) {
+            // scikit-learn trees compare float32 inputs against float64 thresholds
+            for (size_t f = 0; f < featureCount; ++f) {
+                input[f] = static_cast<double>(static_cast<float>(input[f]));
+            }
+        }
+    }
+}
+
+void SignalModel::predict(const double* features, size_t rows, size_t rowStride, int8_t* signals) const {
+    if (rowStride < requiredColumns()) {
+        throw std::invalid_argument("Feature rows are narrower than the model's input columns");
+    }
+    
+    const size_t featureCount = m_columns.size();
+    std::vector<double> inputs(kBlockRows * featureCount);
+    double scores[kBlockRows];
+    
+    for (size_t begin = 0; begin < rows; begin += kBlockRows) {
+        const size_t count = std::min(kBlockRows, rows - begin);
+        standardize(features + begin * rowStride, count, rowStride, inputs.data());
+        
+        if (m_kind == kModelLinear) {
+            for (size_t r = 0; r < count; ++r) {
+                const double* input = inputs.data() + r * featureCount;
+                double score = 0.0;
+                for (size_t f = 0; f < featureCount; ++f) {
+                    score += input[f] * m_coefficients[f];
+                }
+                scores[r] = score + m_intercept;
+            }
+            for (size_t r = 0; r < count; ++r) {
+                signals[begin + r] = m_classes[scores[r] > 0.0];
+            }
+            continue;
+        }
+        
+        // Tree by tree over the block, so each tree's nodes are fetched once
+        // per block. Neighbouring bars have similar features and mostly take
+        // the same path, so the split branches predict well.
+        std::fill(scores, scores + count, 0.0);
+        const ModelNode* nodes = m_nodes.data();
+        for (uint64_t root : m_roots) {
+            for (size_t r = 0; r < count; ++r) {
+                const double* input = inputs.data() + r * featureCount;
+                const ModelNode* node = nodes + root;
+                while (node->feature >= 0) {
+                    node = input[node->feature] <= node->value ? node + 1 : nodes + node->right;
+                }
+                scores[r] += node->value;
+            }
+        }
+        const double half = 0.5 * static_cast<double>(m_roots.size());
+        for (size_t r = 0; r < count; ++r) {
+            signals[begin + r] = m_classes[scores[r] > half];
+        }
+    }
+}
+
+SignalFrame SignalModel::generateSignals(const int64_t* timestamps, const double* close, size_t size) const {
+    const size_t stride = IndicatorEngine::kFeatureCount;
+    if (requiredColumns() > stride) {
+        throw std::invalid_argument("Model reads columns beyond the indicator features");
+    }
+    
+    std::vector<double> features(size * stride);
+    IndicatorEngine::compute(close, size, features.data());
+    
+    // Keep the rows where every indicator is defined, compacting them in place
+    std::vector<int64_t> keptTimestamps;
+    std::vector<double> keptPrices;
+    keptTimestamps.reserve(size > IndicatorEngine::kWarmupRows ? size - IndicatorEngine::kWarmupRows : 0);
+    keptPrices.reserve(keptTimestamps.capacity());
+    for (size_t i = 0; i < size; ++i) {
+        const double* row = features.data() + i * stride;
+        if (std::any_of(row, row + stride, [](double value) { return std::isnan(value); })) {
+            continue;
+        }
+        std::memmove(features.data() + keptTimestamps.size() * stride, row, stride * sizeof(double));
+        keptTimestamps.push_back(timestamps[i]);
+        keptPrices.push_back(close[i]);
+    }
+    
+    std::vector<int8_t> signals(keptTimestamps.size());
+    predict(features.data(), signals.size(), stride, signals.data());
+    return SignalFrame(std::move(keptTimestamps), std::move(keptPrices), std::move(signals));
+}
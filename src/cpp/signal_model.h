@@ -0,0 +1,135 @@
+#ifndef SIGNAL_MODEL_H
+#define SIGNAL_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "signal_frame.h"
+
+/**
+ * Exported model file (little-endian)
+ *
+ * Layout:
+ *   ModelFileHeader                              (64 bytes)
+ *   uint32 columns[featureCount]                 feature matrix column of each input
+ *   float64 mean[featureCount]                   standardization, applied as
+ *   float64 scale[featureCount]                  (x - mean) / scale
+ *   linear models:
+ *     float64 coefficients[featureCount]
+ *     float64 intercept
+ *   tree ensembles:
+ *     uint64 roots[treeCount]                    index of each tree's root node
+ *     ModelNode nodes[nodeCount]                 trees one after another, the first at 0
+ *
+ * Written by write_model_file() in signal_generation.py.
+ */
+struct ModelFileHeader {
+    char magic[8];          // "SQMODEL\0"
+    uint32_t version;       // Format version
+    uint32_t kind;          // ModelKind
+    uint32_t featureCount;  // Inputs per row
+    uint32_t treeCount;     // Trees (tree ensembles only)
+    uint64_t nodeCount;     // Nodes over all trees (tree ensembles only)
+    int32_t classes[2];     // Signal for a negative and a positive prediction
+    uint8_t reserved[24];
+};
+
+/**
+ * Tree node, 16 bytes so four share a cache line
+ *
+ * Trees are stored in depth-first preorder: a split's left child is the
+ * next node and only the right child is linked, so the common path of a
+ * traversal walks forward through memory.
+ */
+struct ModelNode {
+    int32_t feature;  // Input compared at this split, or -1 for a leaf
+    int32_t right;    // Index of the right child (splits only)
+    double value;     // Split threshold (go left if x <= value), or the leaf's positive-class probability
+};
+
+static_assert(sizeof(ModelFileHeader) == 64, "ModelFileHeader layout changed");
+static_assert(sizeof(ModelNode) == 16, "ModelNode layout changed");
+
+enum ModelKind : uint32_t {
+    kModelLinear = 1,        // Logistic regression: positive if w.x + b > 0
+    kModelTreeEnsemble = 2   // Random forest: positive if the mean leaf probability > 0.5
+};
+
+/**
+ * SignalModel class for native batch inference of an exported classifier
+ *
+ * Reproduces predict() of the scikit-learn StandardScaler + LogisticRegression
+ * or RandomForestClassifier pipeline used by SignalGenerator. Tree inputs
+ * are rounded to float32 before comparison, as scikit-learn does, so splits
+ * agree exactly; predictions can differ only where the score is tied at
+ * the decision boundary to within rounding.
+ */
+class SignalModel {
+public:
+    static constexpr uint32_t kVersion = 1;
+    
+    SignalModel();
+    
+    /**
+     * Load an exported model file
+     * 
+     * @param filePath Path to the model file
+     * @param model Loaded model (only written on success)
+     * @return True if successful, false otherwise
+     */
+    static bool load(const std::string& filePath, SignalModel& model);
+    
+    /**
+     * Predict a signal for each row of a feature matrix
+     * 
+     * @param features Row-major feature matrix (e.g. IndicatorEngine::compute output)
+     * @param rows Number of rows
+     * @param rowStride Distance between rows in values; must cover every input column
+     * @param signals Output signal per row
+     */
+    void predict(const double* features, size_t rows, size_t rowStride, int8_t* signals) const;
+    
+    /**
+     * Compute indicator features, predict and build a signal frame in one pass
+     * 
+     * Rows with any undefined indicator (the warm-up bars, for instance)
+     * are dropped, as SignalGenerator.generate_signals does. The model's
+     * input columns refer to IndicatorEngine's feature layout.
+     * 
+     * @param timestamps Timestamps in nanoseconds since the Unix epoch
+     * @param close Close prices
+     * @param size Number of bars
+     * @return Signal frame ready for backtesting
+     */
+    SignalFrame generateSignals(const int64_t* timestamps, const double* close, size_t size) const;
+    
+    ModelKind kind() const { return m_kind; }
+    size_t featureCount() const { return m_columns.size(); }
+    size_t treeCount() const { return m_roots.size(); }
+    size_t nodeCount() const { return m_nodes.size(); }
+    
+    /**
+     * Largest feature matrix column the model reads, plus one
+     */
+    size_t requiredColumns() const;
+    
+private:
+    /**
+     * Standardize a block of rows into the input buffer, one row of
+     * featureCount() values after another
+     */
+    void standardize(const double* features, size_t rows, size_t rowStride, double* inputs) const;
+    
+    ModelKind m_kind;
+    int8_t m_classes[2];
+    std::vector<uint32_t> m_columns;
+    std::vector<double> m_mean;
+    std::vector<double> m_scale;
+    std::vector<double> m_coefficients;
+    double m_intercept;
+    std::vector<uint64_t> m_roots;
+    std::vector<ModelNode> m_nodes;
+};
+
+#endif // SIGNAL_MODEL_H
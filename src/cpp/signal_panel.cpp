@@ -0,0 +1,57 @@
+#include "signal_panel.h"
+#include <stdexcept>
+
+namespace {
+
+struct OwnedPanel {
+    std::vector<int64_t> timestamps;
+    std::vector<double> prices;
+    std::vector<int8_t> signals;
+};
+
+const std::vector<std::string>& noSymbols() {
+    static const std::vector<std::string> empty;
+    return empty;
+}
+
+} // namespace
+
+SignalPanel::SignalPanel()
+    : m_timestamps(nullptr),
+      m_prices(nullptr),
+      m_signals(nullptr),
+      m_numTimes(0) {}
+
+SignalPanel::SignalPanel(std::vector<std::string> symbols, std::vector<int64_t> timestamps,
+                         std::vector<double> prices, std::vector<int8_t> signals)
+    : SignalPanel() {
+    const size_t cells = timestamps.size() * symbols.size();
+    if (prices.size() != cells || signals.size() != cells) {
+        throw std::invalid_argument("SignalPanel blocks must hold one value per timestamp and symbol");
+    }
+    
+    auto columns = std::make_shared<OwnedPanel>();
+    columns->timestamps = std::move(timestamps);
+    columns->prices = std::move(prices);
+    columns->signals = std::move(signals);
+    
+    m_symbols = std::make_shared<const std::vector<std::string>>(std::move(symbols));
+    m_timestamps = columns->timestamps.data();
+    m_prices = columns->prices.data();
+    m_signals = columns->signals.data();
+    m_numTimes = columns->timestamps.size();
+    m_owner = std::move(columns);
+}
+
+SignalPanel::SignalPanel(std::vector<std::string> symbols, size_t numTimes, const int64_t* timestamps,
+                         const double* prices, const int8_t* signals, std::shared_ptr<const void> owner)
+    : m_owner(std::move(owner)),
+      m_symbols(std::make_shared<const std::vector<std::string>>(std::move(symbols))),
+      m_timestamps(timestamps),
+      m_prices(prices),
+      m_signals(signals),
+      m_numTimes(numTimes) {}
+
+const std::vector<std::string>& SignalPanel::symbols() const {
+    return m_symbols ? *m_symbols : noSymbols();
+}
@@ -0,0 +1,89 @@
+#ifndef SIGNAL_PANEL_H
+#define SIGNAL_PANEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Time x symbol panel of prices and signals for many assets
+ *
+ * Prices and signals are stored column-major over (symbol, time): the
+ * cross-section of every timestamp is one contiguous block, with the symbol
+ * index varying fastest. This is the layout of a C-ordered NumPy array of
+ * shape (times, symbols), and lets the portfolio loop stream each timestamp's
+ * cross-section with unit stride. Like SignalFrame, a panel is immutable and
+ * copies share the column storage.
+ */
+class SignalPanel {
+public:
+    /**
+     * Create an empty panel
+     */
+    SignalPanel();
+    
+    /**
+     * Create a panel that takes ownership of the given columns
+     * 
+     * @param symbols Symbol names (one per column of the panel)
+     * @param timestamps Timestamps in nanoseconds since the Unix epoch
+     * @param prices Prices, timestamps.size() * symbols.size() values
+     * @param signals Signals (0 = no position/sell, 1 = buy), same layout as prices
+     * @throws std::invalid_argument if the sizes do not match
+     */
+    SignalPanel(std::vector<std::string> symbols, std::vector<int64_t> timestamps,
+                std::vector<double> prices, std::vector<int8_t> signals);
+    
+    /**
+     * Create a panel over externally owned columns without copying
+     * 
+     * @param symbols Symbol names
+     * @param numTimes Number of timestamps
+     * @param timestamps Timestamp column
+     * @param prices Price block (numTimes * symbols.size() values)
+     * @param signals Signal block (same layout as prices)
+     * @param owner Keeps the column memory alive for the lifetime of the panel
+     *              and all of its copies
+     */
+    SignalPanel(std::vector<std::string> symbols, size_t numTimes, const int64_t* timestamps,
+                const double* prices, const int8_t* signals, std::shared_ptr<const void> owner);
+    
+    size_t numTimes() const { return m_numTimes; }
+    size_t numSymbols() const { return m_symbols ? m_symbols->size() : 0; }
+    bool empty() const { return m_numTimes == 0 || numSymbols() == 0; }
+    
+    const std::vector<std::string>& symbols() const;
+    const int64_t* timestamps() const { return m_timestamps; }
+    const double* prices() const { return m_prices; }
+    const int8_t* signals() const { return m_signals; }
+    
+    int64_t timestamp(size_t t) const { return m_timestamps[t]; }
+    
+    /**
+     * Prices of every symbol at one timestamp
+     * 
+     * @param t Time index
+     * @return Pointer to numSymbols() contiguous prices
+     */
+    const double* pricesAt(size_t t) const { return m_prices + t * numSymbols(); }
+    
+    /**
+     * Signals of every symbol at one timestamp
+     * 
+     * @param t Time index
+     * @return Pointer to numSymbols() contiguous signals
+     */
+    const int8_t* signalsAt(size_t t) const { return m_signals + t * numSymbols(); }
+    
+private:
+    std::shared_ptr<const void> m_owner;  // Keeps the column storage alive
+    std::shared_ptr<const std::vector<std::string>> m_symbols;
+    const int64_t* m_timestamps;
+    const double* m_prices;
+    const int8_t* m_signals;
+    size_t m_numTimes;
+};
+
+#endif // SIGNAL_PANEL_H
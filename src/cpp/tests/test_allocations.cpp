@@ -0,0 +1,101 @@
+/**
+ * Steady-state allocation checks for the backtest loop.
+ *
+ * Replaces the global operator new with a counting one, so it lives in its
+ * own test executable.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "backtester.h"
+#include "run_arena.h"
+#include "test_common.h"
+
+// The replacements are kept out of line so GCC does not pair inlined
+// new/delete calls with malloc/free and warn
+static std::atomic<size_t> g_allocations{0};
+
+#if defined(__GNUC__)
+#define TEST_NOINLINE __attribute__((noinline))
+#else
+#define TEST_NOINLINE
+#endif
+
+TEST_NOINLINE void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+TEST_NOINLINE void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+TEST_NOINLINE void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// std::pmr::new_delete_resource() allocates through the aligned forms
+TEST_NOINLINE void* operator new(std::size_t size, std::align_val_t alignment) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+TEST_NOINLINE void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+TEST_NOINLINE void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+TEST(Allocations, RunBacktestAllocatesNothingAfterWarmUp) {
+    const SignalFrame frame = test::randomFrame(100000);
+    Backtester backtester(10000.0, 0.0005, 0.0);
+    backtester.setSignals(frame);
+    
+    // The first run sizes the buffers; later runs must not allocate
+    backtester.runBacktest();
+    const size_t before = g_allocations.load();
+    for (int run = 0; run < 5; ++run) {
+        backtester.runBacktest();
+    }
+    const size_t allocations = g_allocations.load() - before;
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST(Allocations, ArenaBackedRunsAllocateNothingAfterWarmUp) {
+    const SignalFrame frame = test::randomFrame(100000);
+    RunArena arena;
+    auto runOnce = [&] {
+        {
+            Backtester backtester(10000.0, 0.0005, 0.0, &arena);
+            backtester.setSignals(frame);
+            backtester.runBacktest();
+        }
+        arena.reset();
+    };
+    
+    // A new backtester per run, as in a sweep; the first run sizes the arena
+    runOnce();
+    const size_t before = g_allocations.load();
+    const size_t arenaHeapBefore = arena.stats().heapAllocations;
+    for (int run = 0; run < 5; ++run) {
+        runOnce();
+    }
+    const size_t allocations = g_allocations.load() - before;
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(arena.stats().heapAllocations, arenaHeapBefore);
+}
+
+} // namespace
@@ -0,0 +1,43 @@
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "signal_frame.h"
+
+namespace test {
+
+constexpr int64_t kStartTime = 1672531200LL * 1000000000LL;  // 2023-01-01 00:00:00 UTC
+constexpr int64_t kBarNanos = 1000000000LL;                  // 1 second bars
+
+/**
+ * Random-walk prices with a signal that flips with the given probability
+ * per bar (same shape as the benchmark series, smaller)
+ */
+inline SignalFrame randomFrame(size_t rows, uint64_t seed = 42, double flipProbability = 0.05) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    std::bernoulli_distribution flip(flipProbability);
+    
+    std::vector<int64_t> timestamps(rows);
+    std::vector<double> prices(rows);
+    std::vector<int8_t> signals(rows);
+    
+    double price = 150.0;
+    int8_t signal = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        price *= 1.0 + noise(rng);
+        if (flip(rng)) {
+            signal = static_cast<int8_t>(1 - signal);
+        }
+        timestamps[i] = kStartTime + static_cast<int64_t>(i) * kBarNanos;
+        prices[i] = price;
+        signals[i] = signal;
+    }
+    return SignalFrame(std::move(timestamps), std::move(prices), std::move(signals));
+}
+
+} // namespace test
+
+#endif // TEST_COMMON_H
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "equity_kernels.h"
+
+namespace {
+
+// Odd lengths around and between the 4- and 8-lane widths, plus long tails
+const size_t kSizes[] = {0, 1, 2, 3, 5, 7, 9, 13, 15, 17, 31, 33, 63, 65, 127, 129, 1001, 4099};
+
+struct KernelOutput {
+    std::vector<double> drawdowns;
+    double maxDrawdown = 0.0;
+    double peak = 0.0;
+    std::vector<double> returns;
+    size_t changeCount = 0;
+    std::vector<size_t> changes;
+    std::vector<double> equity;
+};
+
+KernelOutput runKernels(SimdLevel level, const std::vector<double>& prices, const std::vector<int8_t>& signals) {
+    setSimdLevel(level);
+    const size_t size = prices.size();
+    KernelOutput out;
+    out.drawdowns.resize(size);
+    out.peak = 120.0;
+    out.maxDrawdown = computeDrawdowns(prices.data(), size, out.peak, out.drawdowns.data());
+    out.returns.resize(size);
+    computeReturns(prices.data(), size, 99.5, out.returns.data());
+    out.changeCount = countSignalChanges(signals.data(), size, 1);
+    out.changes.resize(out.changeCount);
+    EXPECT_EQ(findSignalChanges(signals.data(), size, 1, out.changes.data()), out.changeCount);
+    out.equity.resize(size);
+    fillEquity(prices.data(), size, 1234.5, 37, out.equity.data());
+    return out;
+}
+
+class EquityKernels : public ::testing::Test {
+protected:
+    void TearDown() override { setSimdLevel(detectSimdLevel()); }
+};
+
+TEST_F(EquityKernels, VectorLevelsMatchScalarOnRaggedLengths) {
+    std::mt19937_64 rng(11);
+    std::normal_distribution<double> noise(0.0, 0.02);
+    std::bernoulli_distribution flip(0.2);
+    
+    for (size_t size : kSizes) {
+        // Random walk with repeated prices, so peaks tie and runs stay flat
+        std::vector<double> prices(size);
+        std::vector<int8_t> signals(size);
+        double price = 100.0;
+        int8_t signal = 1;
+        for (size_t i = 0; i < size; ++i) {
+            if (i % 5 != 0) {
+                price *= 1.0 + noise(rng);
+            }
+            if (flip(rng)) {
+                signal = static_cast<int8_t>(1 - signal);
+            }
+            prices[i] = price;
+            signals[i] = signal;
+        }
+        
+        const KernelOutput scalar = runKernels(SimdLevel::Scalar, prices, signals);
+        for (SimdLevel level : {SimdLevel::AVX2, SimdLevel::AVX512}) {
+            if (level > detectSimdLevel()) {
+                continue;
+            }
+            SCOPED_TRACE(std::string(simdLevelName(level)) + " size " + std::to_string(size));
+            const KernelOutput vector = runKernels(level, prices, signals);
+            EXPECT_EQ(vector.drawdowns, scalar.drawdowns);
+            EXPECT_EQ(vector.maxDrawdown, scalar.maxDrawdown);
+            EXPECT_EQ(vector.peak, scalar.peak);
+            EXPECT_EQ(vector.returns, scalar.returns);
+            EXPECT_EQ(vector.changeCount, scalar.changeCount);
+            EXPECT_EQ(vector.changes, scalar.changes);
+            EXPECT_EQ(vector.equity, scalar.equity);
+        }
+    }
+}
+
+TEST_F(EquityKernels, ScalarDrawdownsFollowTheRunningPeak) {
+    setSimdLevel(SimdLevel::Scalar);
+    const std::vector<double> equity = {100.0, 110.0, 99.0, 121.0, 60.5, 130.0};
+    std::vector<double> drawdowns(equity.size());
+    double peak = 105.0;
+    const double maxDrawdown = computeDrawdowns(equity.data(), equity.size(), peak, drawdowns.data());
+    EXPECT_DOUBLE_EQ(maxDrawdown, 0.5);
+    EXPECT_DOUBLE_EQ(peak, 130.0);
+    EXPECT_DOUBLE_EQ(drawdowns[0], (105.0 - 100.0) / 105.0 * 100.0);
+    EXPECT_DOUBLE_EQ(drawdowns[2], 10.0);
+    EXPECT_DOUBLE_EQ(drawdowns[5], 0.0);
+}
+
+} // namespace
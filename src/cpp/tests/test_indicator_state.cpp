@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "indicator_engine.h"
+#include "indicators.h"
+
+namespace {
+
+constexpr size_t kColumns = IndicatorEngine::kFeatureCount;
+
+// Random walk with a flat stretch and one-sided runs (zero deviation,
+// 0/0 RSI, RSI 100 and RSI 0)
+std::vector<double> closesWithFlatStretches(size_t size) {
+    std::mt19937_64 rng(17);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    std::vector<double> close(size);
+    double price = 100.0;
+    for (size_t i = 0; i < size; ++i) {
+        const size_t phase = i % 1000;
+        if (phase >= 100 && phase < 140) {
+            // Flat
+        } else if (phase >= 200 && phase < 230) {
+            price *= 1.002;
+        } else if (phase >= 300 && phase < 330) {
+            price *= 0.998;
+        } else {
+            price *= 1.0 + noise(rng);
+        }
+        close[i] = price;
+    }
+    return close;
+}
+
+bool sameValue(double a, double b, double tolerance) {
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) && std::isnan(b);
+    }
+    return std::abs(a - b) <= tolerance * std::max(1.0, std::abs(b));
+}
+
+TEST(IndicatorState, UpdateMatchesIndicatorEngineCompute) {
+    const std::vector<double> close = closesWithFlatStretches(5000);
+    std::vector<double> batch(close.size() * kColumns);
+    IndicatorEngine::compute(close.data(), close.size(), batch.data());
+    
+    IndicatorState state;
+    double row[kColumns];
+    for (size_t i = 0; i < close.size(); ++i) {
+        state.update(close[i], row);
+        EXPECT_EQ(state.ready(), i >= IndicatorEngine::kWarmupRows);
+        for (size_t c = 0; c < kColumns; ++c) {
+            ASSERT_TRUE(sameValue(row[c], batch[i * kColumns + c], 1e-10))
+                << IndicatorEngine::featureName(c) << " at bar " << i << ": " << row[c]
+                << " vs " << batch[i * kColumns + c];
+        }
+    }
+}
+
+TEST(IndicatorState, CheckpointResumeIsBitIdentical) {
+    const std::vector<double> close = closesWithFlatStretches(5000);
+    
+    IndicatorState uninterrupted;
+    std::vector<double> expected(close.size() * kColumns);
+    for (size_t i = 0; i < close.size(); ++i) {
+        uninterrupted.update(close[i], expected.data() + i * kColumns);
+    }
+    
+    // Save and restore every 777 bars, continuing from the restored copy
+    IndicatorState state;
+    std::vector<double> resumed(close.size() * kColumns);
+    for (size_t i = 0; i < close.size(); ++i) {
+        if (i % 777 == 0) {
+            state = loadIndicatorState<IndicatorState>(saveIndicatorState(state));
+        }
+        state.update(close[i], resumed.data() + i * kColumns);
+    }
+    
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const bool bothNan = std::isnan(resumed[i]) && std::isnan(expected[i]);
+        ASSERT_TRUE(bothNan || resumed[i] == expected[i]) << "value " << i;
+    }
+    EXPECT_EQ(saveIndicatorState(state), saveIndicatorState(uninterrupted));
+}
+
+TEST(IndicatorState, LoadRejectsTruncatedState) {
+    IndicatorState state;
+    double row[kColumns];
+    for (double close : closesWithFlatStretches(100)) {
+        state.update(close, row);
+    }
+    const std::string bytes = saveIndicatorState(state);
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        EXPECT_THROW(loadIndicatorState<IndicatorState>(bytes.substr(0, size)), std::invalid_argument)
+            << "prefix of " << size << " bytes";
+    }
+    EXPECT_THROW(loadIndicatorState<IndicatorState>(bytes + '\0'), std::invalid_argument);
+}
+
+// Overwrite the uint64 field at an offset of a saved state
+std::string patched(std::string bytes, size_t offset, uint64_t value) {
+    std::memcpy(&bytes[offset], &value, sizeof(value));
+    return bytes;
+}
+
+TEST(IndicatorState, LoadRejectsCorruptWindow) {
+    // The window follows the 4-byte tag; a huge one must not be allocated
+    const std::string sma = saveIndicatorState(Sma(5));
+    for (uint64_t window : {uint64_t(1) << 40, uint64_t(100000000), uint64_t(6)}) {
+        EXPECT_THROW(loadIndicatorState<Sma>(patched(sma, 4, window)), std::invalid_argument) << window;
+    }
+    const std::string rolling = saveIndicatorState(RollingStd(20));
+    EXPECT_THROW(loadIndicatorState<RollingStd>(patched(rolling, 4, uint64_t(1) << 40)), std::invalid_argument);
+    
+    // The first Sma's window in a full state, after the bar count and close
+    const std::string state = saveIndicatorState(IndicatorState());
+    EXPECT_THROW(loadIndicatorState<IndicatorState>(patched(state, 24, uint64_t(1) << 40)), std::invalid_argument);
+}
+
+TEST(IndicatorState, LoadRejectsCounterPastItsBound) {
+    // RollingStd(3) after one value: tag, window, buffer (size and three
+    // values), next, count = 1, then the run of repeats
+    RollingStd rolling(3);
+    rolling.update(1.0);
+    const std::string bytes = saveIndicatorState(rolling);
+    EXPECT_NO_THROW(loadIndicatorState<RollingStd>(patched(bytes, 60, 1)));
+    EXPECT_THROW(loadIndicatorState<RollingStd>(patched(bytes, 60, 2)), std::invalid_argument);
+    
+    // WilderRsi(14) after three prices: tag, period, then 2 changes
+    WilderRsi rsi(14);
+    for (double price : {1.0, 2.0, 3.0}) {
+        rsi.update(price);
+    }
+    const std::string rsiBytes = saveIndicatorState(rsi);
+    EXPECT_NO_THROW(loadIndicatorState<WilderRsi>(patched(rsiBytes, 12, 2)));
+    EXPECT_THROW(loadIndicatorState<WilderRsi>(patched(rsiBytes, 12, 15)), std::invalid_argument);
+}
+
+TEST(IndicatorState, LoadRejectsWrongTag) {
+    const std::string bytes = saveIndicatorState(IndicatorState());
+    std::string wrongTag = bytes;
+    wrongTag[0] = static_cast<char>(wrongTag[0] ^ 0x20);
+    EXPECT_THROW(loadIndicatorState<IndicatorState>(wrongTag), std::invalid_argument);
+    
+    // A checkpoint of another indicator
+    EXPECT_THROW(loadIndicatorState<IndicatorState>(saveIndicatorState(Sma(5))), std::invalid_argument);
+    EXPECT_THROW(loadIndicatorState<Sma>(bytes), std::invalid_argument);
+}
+
+TEST(IndicatorState, SmaRoundTripKeepsWindow) {
+    Sma sma(5);
+    for (double value : {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}) {
+        sma.update(value);
+    }
+    Sma restored = loadIndicatorState<Sma>(saveIndicatorState(sma));
+    EXPECT_EQ(restored.window(), 5u);
+    EXPECT_TRUE(restored.ready());
+    EXPECT_EQ(restored.update(7.0), sma.update(7.0));
+}
+
+} // namespace
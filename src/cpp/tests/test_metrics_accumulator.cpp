@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "metrics_accumulator.h"
+
+namespace {
+
+std::vector<double> randomEquity(size_t size, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> noise(0.0002, 0.02);
+    std::vector<double> equity(size);
+    double value = 10000.0;
+    for (double& e : equity) {
+        value *= 1.0 + noise(rng);
+        e = value;
+    }
+    return equity;
+}
+
+void expectSameMetrics(const MetricsAccumulator& merged, const MetricsAccumulator& single) {
+    const double tolerance = 1e-12;
+    EXPECT_EQ(merged.count(), single.count());
+    EXPECT_NEAR(merged.mean(), single.mean(), tolerance * std::abs(single.mean()));
+    EXPECT_NEAR(merged.variance(), single.variance(), tolerance * single.variance());
+    EXPECT_NEAR(merged.downsideDeviation(), single.downsideDeviation(), tolerance * single.downsideDeviation());
+    EXPECT_NEAR(merged.sharpeRatio(), single.sharpeRatio(), tolerance * std::abs(single.sharpeRatio()) + 1e-12);
+    EXPECT_NEAR(merged.sortinoRatio(), single.sortinoRatio(), tolerance * std::abs(single.sortinoRatio()) + 1e-12);
+    EXPECT_DOUBLE_EQ(merged.maxDrawdown(), single.maxDrawdown());
+    EXPECT_DOUBLE_EQ(merged.currentDrawdown(), single.currentDrawdown());
+    EXPECT_DOUBLE_EQ(merged.firstEquity(), single.firstEquity());
+    EXPECT_DOUBLE_EQ(merged.lastEquity(), single.lastEquity());
+    EXPECT_DOUBLE_EQ(merged.peakEquity(), single.peakEquity());
+    EXPECT_DOUBLE_EQ(merged.lastReturn(), single.lastReturn());
+}
+
+TEST(MetricsAccumulator, MergeOfChunksEqualsSinglePass) {
+    const std::vector<double> equity = randomEquity(5000, 3);
+    MetricsAccumulator single;
+    for (double e : equity) {
+        single.update(e);
+    }
+    
+    // Uneven chunk sizes, including single-value chunks
+    for (size_t chunkSize : {1, 2, 7, 100, 1250, 4999}) {
+        MetricsAccumulator merged;
+        for (size_t begin = 0; begin < equity.size(); begin += chunkSize) {
+            MetricsAccumulator chunk;
+            for (size_t i = begin; i < std::min(begin + chunkSize, equity.size()); ++i) {
+                chunk.update(equity[i]);
+            }
+            merged.merge(chunk);
+        }
+        SCOPED_TRACE(chunkSize);
+        expectSameMetrics(merged, single);
+    }
+}
+
+TEST(MetricsAccumulator, MergeAcrossANewPeakAndADeepDrawdown) {
+    // The second chunk dips below the first chunk's peak, then sets a new one
+    const std::vector<double> first = {100.0, 120.0, 110.0};
+    const std::vector<double> second = {90.0, 60.0, 130.0, 125.0, 70.0, 140.0};
+    MetricsAccumulator single;
+    MetricsAccumulator head;
+    MetricsAccumulator tail;
+    for (double e : first) {
+        single.update(e);
+        head.update(e);
+    }
+    for (double e : second) {
+        single.update(e);
+        tail.update(e);
+    }
+    head.merge(tail);
+    expectSameMetrics(head, single);
+    EXPECT_DOUBLE_EQ(head.maxDrawdown(), 50.0);
+}
+
+TEST(MetricsAccumulator, MergeWithEmptyAccumulators) {
+    const std::vector<double> equity = randomEquity(100, 5);
+    MetricsAccumulator single;
+    for (double e : equity) {
+        single.update(e);
+    }
+    
+    MetricsAccumulator merged;
+    merged.merge(MetricsAccumulator());
+    merged.merge(single);
+    merged.merge(MetricsAccumulator());
+    expectSameMetrics(merged, single);
+}
+
+TEST(MetricsAccumulator, MergeOfSeededChunksIncludesTheBoundaryReturn) {
+    // As in Backtester: the first chunk is seeded with the initial capital
+    const std::vector<double> equity = randomEquity(1000, 9);
+    MetricsAccumulator single(10000.0);
+    for (double e : equity) {
+        single.update(e);
+    }
+    
+    MetricsAccumulator merged(10000.0);
+    for (size_t i = 0; i < 400; ++i) {
+        merged.update(equity[i]);
+    }
+    MetricsAccumulator tail;
+    for (size_t i = 400; i < equity.size(); ++i) {
+        tail.update(equity[i]);
+    }
+    merged.merge(tail);
+    expectSameMetrics(merged, single);
+    EXPECT_EQ(merged.count(), equity.size());
+}
+
+} // namespace
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "backtester.h"
+#include "portfolio_backtester.h"
+#include "test_common.h"
+
+namespace {
+
+SignalPanel panelOf(const std::vector<SignalFrame>& frames) {
+    const size_t times = frames.front().size();
+    const size_t symbols = frames.size();
+    std::vector<std::string> names;
+    std::vector<int64_t> timestamps(frames.front().timestamps(), frames.front().timestamps() + times);
+    std::vector<double> prices(times * symbols);
+    std::vector<int8_t> signals(times * symbols);
+    for (size_t s = 0; s < symbols; ++s) {
+        names.push_back("SYM" + std::to_string(s));
+        for (size_t t = 0; t < times; ++t) {
+            prices[t * symbols + s] = frames[s].price(t);
+            signals[t * symbols + s] = frames[s].signal(t);
+        }
+    }
+    return SignalPanel(std::move(names), std::move(timestamps), std::move(prices), std::move(signals));
+}
+
+class PortfolioLatency : public ::testing::TestWithParam<double> {};
+
+TEST_P(PortfolioLatency, SingleSymbolMatchesBacktester) {
+    const double latency = GetParam();
+    const SignalFrame frame = test::randomFrame(20000);
+    
+    Backtester backtester(10000.0, 0.0005, latency);
+    backtester.setSignals(frame);
+    backtester.runBacktest();
+    
+    PortfolioBacktester portfolio(10000.0, 0.0005, latency);
+    portfolio.setPanel(panelOf({frame}));
+    portfolio.runBacktest();
+    
+    const BacktestResults expected = backtester.getResults();
+    const BacktestResults actual = portfolio.getResults();
+    EXPECT_DOUBLE_EQ(actual.finalEquity, expected.finalEquity);
+    EXPECT_DOUBLE_EQ(actual.finalReturn, expected.finalReturn);
+    EXPECT_DOUBLE_EQ(actual.maxDrawdown, expected.maxDrawdown);
+    EXPECT_NEAR(actual.sharpeRatio, expected.sharpeRatio, 1e-9);
+    EXPECT_EQ(actual.totalTrades, expected.totalTrades);
+    
+    ASSERT_EQ(portfolio.getEquity().size(), backtester.getEquity().size());
+    for (size_t i = 0; i < frame.size(); ++i) {
+        ASSERT_DOUBLE_EQ(portfolio.getEquity()[i], backtester.getEquity()[i]) << "row " << i;
+    }
+    
+    const auto& fills = portfolio.getTrades();
+    const auto& trades = backtester.getTrades();
+    ASSERT_EQ(fills.size(), trades.size());
+    for (size_t i = 0; i < trades.size(); ++i) {
+        EXPECT_EQ(fills[i].symbol, 0u);
+        EXPECT_EQ(fills[i].fill.timestamp, trades[i].timestamp);
+        EXPECT_EQ(fills[i].fill.side, trades[i].side);
+        EXPECT_EQ(fills[i].fill.shares, trades[i].shares);
+        EXPECT_DOUBLE_EQ(fills[i].fill.price, trades[i].price);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Latencies, PortfolioLatency, ::testing::Values(0.0, 2.5));
+
+TEST(PortfolioBacktester, EqualSleevesSumToPerSymbolBacktests) {
+    std::vector<SignalFrame> frames;
+    for (uint64_t seed = 1; seed <= 5; ++seed) {
+        frames.push_back(test::randomFrame(5000, seed, 0.02 * static_cast<double>(seed)));
+    }
+    
+    PortfolioBacktester portfolio(50000.0, 0.001, 0.0);
+    portfolio.setPanel(panelOf(frames));
+    portfolio.runBacktest();
+    
+    std::vector<double> expected(frames.front().size(), 0.0);
+    int totalTrades = 0;
+    for (const SignalFrame& frame : frames) {
+        Backtester backtester(10000.0, 0.001, 0.0);
+        backtester.setSignals(frame);
+        backtester.runBacktest();
+        for (size_t i = 0; i < expected.size(); ++i) {
+            expected[i] += backtester.getEquity()[i];
+        }
+        totalTrades += backtester.getResults().totalTrades;
+    }
+    
+    ASSERT_EQ(portfolio.getEquity().size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_NEAR(portfolio.getEquity()[i], expected[i], 1e-9 * expected[i]) << "row " << i;
+    }
+    EXPECT_EQ(portfolio.getResults().totalTrades, totalTrades);
+}
+
+} // namespace
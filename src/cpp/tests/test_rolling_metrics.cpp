@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include "rolling_metrics.h"
+
+namespace {
+
+struct WindowMetrics {
+    double volatility;
+    double sharpe;
+    double sortino;
+    double drawdown;
+};
+
+// Direct recomputation over the window ending at bar `end`, with the same
+// definitions as MetricsAccumulator
+WindowMetrics bruteForce(const std::vector<double>& equity, size_t end, size_t window, double riskFreeRate) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    WindowMetrics metrics = {nan, nan, nan, 0.0};
+    
+    const size_t first = end + 1 > window ? end + 1 - window : 0;
+    const double peak = *std::max_element(equity.begin() + first, equity.begin() + end + 1);
+    metrics.drawdown = (peak - equity[end]) / peak * 100.0;
+    if (end < window) {
+        return metrics;
+    }
+    
+    std::vector<double> returns;
+    for (size_t j = end + 1 - window; j <= end; ++j) {
+        returns.push_back(equity[j] / equity[j - 1] - 1.0);
+    }
+    double mean = 0.0;
+    for (double r : returns) {
+        mean += r;
+    }
+    mean /= static_cast<double>(window);
+    double m2 = 0.0;
+    double downsideSumSq = 0.0;
+    size_t downsideCount = 0;
+    for (double r : returns) {
+        m2 += (r - mean) * (r - mean);
+        if (r < 0) {
+            downsideSumSq += r * r;
+            ++downsideCount;
+        }
+    }
+    const double stdDev = std::sqrt(m2 / static_cast<double>(window));
+    const double downside = downsideCount > 0 ? std::sqrt(downsideSumSq / static_cast<double>(downsideCount)) : 0.0;
+    const double excess = mean - riskFreeRate / 252.0;
+    metrics.volatility = stdDev * std::sqrt(252.0);
+    metrics.sharpe = stdDev == 0.0 ? 0.0 : excess / stdDev * std::sqrt(252.0);
+    metrics.sortino = downside == 0.0 ? 0.0 : excess / downside * std::sqrt(252.0);
+    return metrics;
+}
+
+void expectClose(double actual, double expected, const char* name, size_t bar) {
+    if (std::isnan(expected)) {
+        EXPECT_TRUE(std::isnan(actual)) << name << " at bar " << bar;
+        return;
+    }
+    EXPECT_NEAR(actual, expected, 1e-9 * std::max(1.0, std::abs(expected))) << name << " at bar " << bar;
+}
+
+// Random walk with a flat stretch longer than every window
+std::vector<double> equityWithFlatStretch() {
+    std::mt19937_64 rng(21);
+    std::normal_distribution<double> noise(0.0003, 0.015);
+    std::vector<double> equity;
+    double value = 10000.0;
+    for (size_t i = 0; i < 3000; ++i) {
+        if (i < 1000 || i >= 1400) {
+            value *= 1.0 + noise(rng);
+        }
+        equity.push_back(value);
+    }
+    return equity;
+}
+
+class RollingWindow : public ::testing::TestWithParam<size_t> {};
+
+TEST_P(RollingWindow, MatchesBruteForceRecomputation) {
+    const size_t window = GetParam();
+    const double riskFreeRate = 0.02;
+    const std::vector<double> equity = equityWithFlatStretch();
+    
+    const std::vector<RollingSeries> series = computeRollingMetrics(equity.data(), equity.size(), {window}, riskFreeRate);
+    ASSERT_EQ(series.size(), 1u);
+    const RollingSeries& out = series.front();
+    for (size_t i = 0; i < equity.size(); ++i) {
+        const WindowMetrics expected = bruteForce(equity, i, window, riskFreeRate);
+        expectClose(out.volatility[i], expected.volatility, "volatility", i);
+        expectClose(out.sharpe[i], expected.sharpe, "sharpe", i);
+        expectClose(out.sortino[i], expected.sortino, "sortino", i);
+        expectClose(out.drawdown[i], expected.drawdown, "drawdown", i);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Windows, RollingWindow, ::testing::Values(1, 2, 20, 60, 252));
+
+TEST(RollingMetrics, AllFlatWindowIsExactlyZero) {
+    const std::vector<double> equity = equityWithFlatStretch();
+    RollingMetrics metrics(60, 0.02);
+    for (size_t i = 0; i < 1300; ++i) {
+        metrics.update(equity[i]);
+    }
+    
+    // The last 60 returns are all zero after 300 flat bars
+    EXPECT_EQ(metrics.volatility(), 0.0);
+    EXPECT_EQ(metrics.sharpeRatio(), 0.0);
+    EXPECT_EQ(metrics.sortinoRatio(), 0.0);
+    EXPECT_EQ(metrics.drawdown(), 0.0);
+}
+
+TEST(RollingMetrics, ResetForgetsEarlierBars) {
+    const std::vector<double> equity = equityWithFlatStretch();
+    RollingMetrics metrics(20);
+    for (size_t i = 0; i < 500; ++i) {
+        metrics.update(equity[i]);
+    }
+    metrics.reset();
+    EXPECT_FALSE(metrics.full());
+    EXPECT_TRUE(std::isnan(metrics.sharpeRatio()));
+    EXPECT_EQ(metrics.drawdown(), 0.0);
+}
+
+} // namespace
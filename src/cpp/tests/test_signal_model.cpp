@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "signal_model.h"
+
+namespace {
+
+struct ModelSpec {
+    ModelKind kind = kModelTreeEnsemble;
+    std::vector<uint32_t> columns = {0, 1};
+    std::vector<double> mean = {0.0, 0.0};
+    std::vector<double> scale = {1.0, 1.0};
+    std::vector<double> coefficients;  // Linear models (the intercept last)
+    std::vector<uint64_t> roots;
+    std::vector<ModelNode> nodes;
+};
+
+// Write a model file in the layout documented in signal_model.h
+std::string writeModel(const ModelSpec& spec, const std::string& name) {
+    const std::string path = "test_signal_model_" + name + ".sqm";
+    ModelFileHeader header = {};
+    std::memcpy(header.magic, "SQMODEL", 8);
+    header.version = SignalModel::kVersion;
+    header.kind = spec.kind;
+    header.featureCount = static_cast<uint32_t>(spec.columns.size());
+    header.treeCount = static_cast<uint32_t>(spec.roots.size());
+    header.nodeCount = spec.nodes.size();
+    header.classes[0] = 0;
+    header.classes[1] = 1;
+    
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(spec.columns.data()), spec.columns.size() * sizeof(uint32_t));
+    out.write(reinterpret_cast<const char*>(spec.mean.data()), spec.mean.size() * sizeof(double));
+    out.write(reinterpret_cast<const char*>(spec.scale.data()), spec.scale.size() * sizeof(double));
+    out.write(reinterpret_cast<const char*>(spec.coefficients.data()), spec.coefficients.size() * sizeof(double));
+    out.write(reinterpret_cast<const char*>(spec.roots.data()), spec.roots.size() * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(spec.nodes.data()), spec.nodes.size() * sizeof(ModelNode));
+    return path;
+}
+
+bool loads(const ModelSpec& spec, const std::string& name) {
+    const std::string path = writeModel(spec, name);
+    SignalModel model;
+    const bool loaded = SignalModel::load(path, model);
+    std::remove(path.c_str());
+    return loaded;
+}
+
+// Two stumps: x0 <= 0 and x1 <= 1, each voting 0.9 for its right side
+ModelSpec twoStumps() {
+    ModelSpec spec;
+    spec.roots = {0, 3};
+    spec.nodes = {
+        {0, 2, 0.0}, {-1, 0, 0.1}, {-1, 0, 0.9},
+        {1, 5, 1.0}, {-1, 0, 0.1}, {-1, 0, 0.9},
+    };
+    return spec;
+}
+
+TEST(SignalModel, PredictsTreeEnsembleByMeanLeafProbability) {
+    const std::string path = writeModel(twoStumps(), "stumps");
+    SignalModel model;
+    ASSERT_TRUE(SignalModel::load(path, model));
+    std::remove(path.c_str());
+    EXPECT_EQ(model.kind(), kModelTreeEnsemble);
+    EXPECT_EQ(model.treeCount(), 2u);
+    EXPECT_EQ(model.nodeCount(), 6u);
+    
+    // Rows of three columns; the model reads the first two
+    const std::vector<double> features = {
+        -1.0, 0.0, 7.0,   // 0.1 + 0.1
+        1.0, 0.0, 7.0,    // 0.9 + 0.1: mean 0.5 is not above one half
+        1.0, 2.0, 7.0,    // 0.9 + 0.9
+        0.0, 1.0, 7.0,    // Thresholds go left
+    };
+    std::vector<int8_t> signals(4);
+    model.predict(features.data(), 4, 3, signals.data());
+    EXPECT_EQ(signals, (std::vector<int8_t>{0, 0, 1, 0}));
+}
+
+TEST(SignalModel, PredictsLinearModelOnStandardizedInputs) {
+    ModelSpec spec;
+    spec.kind = kModelLinear;
+    spec.columns = {1, 0};
+    spec.mean = {10.0, 0.0};
+    spec.scale = {2.0, 1.0};
+    spec.coefficients = {1.0, -1.0, 0.5};  // Score: (x1 - 10) / 2 - x0 + 0.5
+    const std::string path = writeModel(spec, "linear");
+    SignalModel model;
+    ASSERT_TRUE(SignalModel::load(path, model));
+    std::remove(path.c_str());
+    
+    const std::vector<double> features = {0.0, 10.0, 1.0, 10.0, 0.0, 9.0, -3.0, 4.0};
+    std::vector<int8_t> signals(4);
+    model.predict(features.data(), 4, 2, signals.data());
+    EXPECT_EQ(signals, (std::vector<int8_t>{1, 0, 0, 1}));
+}
+
+TEST(SignalModel, RejectsRootsPastTheNodeArray) {
+    // Three nodes, but the first tree's range runs to the second root at
+    // 100; node 1's right child (node 3) lies past the end of the array
+    ModelSpec spec;
+    spec.roots = {0, 100};
+    spec.nodes = {{0, 4, 0.0}, {1, 3, 0.0}, {-1, 0, 0.5}};
+    EXPECT_FALSE(loads(spec, "roots_past_nodes"));
+    
+    spec.roots = {0, 3};
+    EXPECT_FALSE(loads(spec, "root_at_node_count"));
+}
+
+TEST(SignalModel, RejectsRootsOutOfOrder) {
+    ModelSpec spec = twoStumps();
+    spec.roots = {0, 0};
+    EXPECT_FALSE(loads(spec, "repeated_root"));
+    spec.roots = {3, 0};
+    EXPECT_FALSE(loads(spec, "decreasing_roots"));
+    spec.roots = {1, 3};
+    EXPECT_FALSE(loads(spec, "first_root_not_zero"));
+    EXPECT_TRUE(loads(twoStumps(), "valid"));
+}
+
+TEST(SignalModel, RejectsMalformedTrees) {
+    ModelSpec spec = twoStumps();
+    spec.nodes[0].right = 1;  // Right child where the left one must be
+    EXPECT_FALSE(loads(spec, "right_is_left"));
+    
+    spec = twoStumps();
+    spec.nodes[3].feature = 2;  // Only two inputs
+    EXPECT_FALSE(loads(spec, "feature_out_of_range"));
+    
+    spec = twoStumps();
+    spec.nodes.push_back({-1, 0, 0.5});  // Unreachable trailing node
+    EXPECT_FALSE(loads(spec, "unreachable_node"));
+}
+
+TEST(SignalModel, RejectsTruncatedFile) {
+    const std::string path = writeModel(twoStumps(), "truncated");
+    std::ifstream in(path, std::ios::binary);
+    const std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    SignalModel model;
+    EXPECT_FALSE(SignalModel::load(path, model));
+    std::remove(path.c_str());
+}
+
+} // namespace
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "backtester.h"
+#include "timestamp.h"
+
+namespace {
+
+bool parse(const char* text, int64_t& nanos) {
+    return parseTimestamp(text, text + std::strlen(text), nanos);
+}
+
+bool valid(const char* text) {
+    int64_t nanos = 0;
+    return parse(text, nanos);
+}
+
+TEST(Timestamp, ParsesPandasFormats) {
+    int64_t nanos = 0;
+    ASSERT_TRUE(parse("2023-01-01", nanos));
+    EXPECT_EQ(nanos, 1672531200LL * 1000000000LL);
+    ASSERT_TRUE(parse("2023-01-01 00:00:01.5", nanos));
+    EXPECT_EQ(nanos, 1672531201LL * 1000000000LL + 500000000LL);
+    ASSERT_TRUE(parse("2023-01-01T01:00:00+01:00", nanos));
+    EXPECT_EQ(nanos, 1672531200LL * 1000000000LL);
+    EXPECT_EQ(formatTimestamp(nanos), "2023-01-01 00:00:00");
+}
+
+TEST(Timestamp, AcceptsLastDayOfEachMonth) {
+    EXPECT_TRUE(valid("2023-01-31"));
+    EXPECT_TRUE(valid("2023-02-28"));
+    EXPECT_TRUE(valid("2023-04-30"));
+    EXPECT_TRUE(valid("2023-12-31"));
+    EXPECT_TRUE(valid("2024-02-29"));
+    EXPECT_TRUE(valid("2000-02-29"));
+}
+
+TEST(Timestamp, RejectsDaysPastTheEndOfTheMonth) {
+    EXPECT_FALSE(valid("2024-02-31"));
+    EXPECT_FALSE(valid("2024-02-30"));
+    EXPECT_FALSE(valid("2023-02-29"));
+    EXPECT_FALSE(valid("1900-02-29"));
+    EXPECT_FALSE(valid("2023-04-31"));
+    EXPECT_FALSE(valid("2023-06-31 12:00:00"));
+    EXPECT_FALSE(valid("2023-11-31T00:00:00Z"));
+    EXPECT_FALSE(valid("2023-01-32"));
+    EXPECT_FALSE(valid("2023-01-00"));
+    EXPECT_FALSE(valid("2023-13-01"));
+}
+
+TEST(Timestamp, CsvLoaderSkipsRowsWithImpossibleDates) {
+    const std::string path = "test_timestamp_signals.csv";
+    {
+        std::ofstream out(path);
+        out << "timestamp,price,signal\n"
+            << "2023-02-28,100.0,1\n"
+            << "2023-02-31,101.0,0\n"
+            << "2023-03-01,102.0,0\n";
+    }
+    Backtester mapped;
+    ASSERT_TRUE(mapped.loadSignalsFromCSVMapped(path));
+    EXPECT_EQ(mapped.getSignals().size(), 2u);
+    Backtester stream;
+    ASSERT_TRUE(stream.loadSignalsFromCSVStream(path));
+    EXPECT_EQ(stream.getSignals().size(), 2u);
+    std::remove(path.c_str());
+}
+
+} // namespace
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "backtester.h"
+#include "test_common.h"
+#include "walk_forward.h"
+
+namespace {
+
+// Candidate-major signals of several frames over the first frame's bars
+struct Candidates {
+    std::vector<int64_t> timestamps;
+    std::vector<double> prices;
+    std::vector<int8_t> signals;
+    
+    WalkForward store() const {
+        const size_t size = prices.size();
+        return WalkForward(size, timestamps.data(), prices.data(), signals.data(), signals.size() / size, nullptr);
+    }
+};
+
+Candidates candidatesOf(const std::vector<SignalFrame>& frames) {
+    const SignalFrame& front = frames.front();
+    Candidates candidates;
+    candidates.timestamps.assign(front.timestamps(), front.timestamps() + front.size());
+    candidates.prices.assign(front.prices(), front.prices() + front.size());
+    for (const SignalFrame& frame : frames) {
+        candidates.signals.insert(candidates.signals.end(), frame.signals(), frame.signals() + front.size());
+    }
+    return candidates;
+}
+
+// Sharpe ratio of the net returns at bars begin + 1 .. end - 1, computed
+// bar by bar
+double directSharpe(const Candidates& candidates, size_t candidate, size_t begin, size_t end, double slippage) {
+    const int8_t* signals = candidates.signals.data() + candidate * candidates.prices.size();
+    std::vector<double> returns;
+    for (size_t i = begin + 1; i < end; ++i) {
+        double net = signals[i - 1] != 0 ? candidates.prices[i] / candidates.prices[i - 1] - 1.0 : 0.0;
+        if (signals[i] != signals[i - 1]) {
+            net -= slippage;
+        }
+        returns.push_back(net);
+    }
+    double mean = 0.0;
+    for (double r : returns) {
+        mean += r;
+    }
+    mean /= static_cast<double>(returns.size());
+    double variance = 0.0;
+    for (double r : returns) {
+        variance += (r - mean) * (r - mean);
+    }
+    variance /= static_cast<double>(returns.size());
+    return variance > 1e-24 ? mean / std::sqrt(variance) * std::sqrt(252.0) : 0.0;
+}
+
+TEST(WalkForward, MakeFoldsCoversEveryTestBar) {
+    const std::vector<WalkForwardFold> folds = WalkForward::makeFolds({300, 100, false}, 950);
+    ASSERT_EQ(folds.size(), 7u);
+    for (size_t k = 0; k < folds.size(); ++k) {
+        EXPECT_EQ(folds[k].testBegin, 300 + 100 * k);
+        EXPECT_EQ(folds[k].trainEnd, folds[k].testBegin);
+        EXPECT_EQ(folds[k].trainBegin, folds[k].testBegin - 300);
+    }
+    EXPECT_EQ(folds.back().testEnd, 950u);
+    
+    EXPECT_EQ(WalkForward::makeFolds({300, 100, true}, 950).back().trainBegin, 0u);
+    EXPECT_TRUE(WalkForward::makeFolds({300, 100, false}, 300).empty());
+    EXPECT_THROW(WalkForward::makeFolds({1, 100, false}, 950), std::invalid_argument);
+    EXPECT_THROW(WalkForward::makeFolds({300, 0, false}, 950), std::invalid_argument);
+}
+
+TEST(WalkForward, TrainSharpeMatchesDirectSharpe) {
+    // One candidate, so each fold's score is that candidate's
+    const Candidates candidates = candidatesOf({test::randomFrame(3000, 7, 0.1)});
+    const WalkForward store = candidates.store();
+    for (bool anchored : {false, true}) {
+        for (double slippage : {0.0, 0.0005, 0.01}) {
+            SweepConfig config;
+            config.slippage = slippage;
+            const WalkForwardResults results = store.run({400, 150, anchored}, config, 2);
+            ASSERT_FALSE(results.folds.empty());
+            for (const WalkForwardFold& fold : results.folds) {
+                const double expected = directSharpe(candidates, 0, fold.trainBegin, fold.trainEnd, slippage);
+                EXPECT_NEAR(fold.trainSharpe, expected, 1e-8 * std::max(1.0, std::abs(expected)))
+                    << "fold at " << fold.testBegin << ", slippage " << slippage;
+            }
+        }
+    }
+}
+
+TEST(WalkForward, PicksTheBestInSampleCandidate) {
+    std::vector<SignalFrame> frames;
+    for (uint64_t seed = 1; seed <= 6; ++seed) {
+        frames.push_back(test::randomFrame(2000, seed, 0.05));
+    }
+    const Candidates candidates = candidatesOf(frames);
+    const WalkForwardResults results = candidates.store().run({250, 250, false}, SweepConfig(), 3);
+    for (const WalkForwardFold& fold : results.folds) {
+        for (size_t c = 0; c < frames.size(); ++c) {
+            EXPECT_LE(directSharpe(candidates, c, fold.trainBegin, fold.trainEnd, 0.0005), fold.trainSharpe + 1e-8)
+                << "fold at " << fold.testBegin << ", candidate " << c;
+        }
+    }
+}
+
+TEST(WalkForward, AlwaysLongStitchesToBuyAndHold) {
+    // 1000 bars rising 0.1% per bar, one candidate that is always long
+    std::vector<int64_t> timestamps(1000);
+    std::vector<double> prices(1000);
+    std::vector<int8_t> signals(1000, 1);
+    double price = 100.0;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        timestamps[i] = test::kStartTime + static_cast<int64_t>(i) * test::kBarNanos;
+        prices[i] = price;
+        price *= 1.001;
+    }
+    const WalkForward store(prices.size(), timestamps.data(), prices.data(), signals.data(), 1, nullptr);
+    const SweepConfig config;
+    const WalkForwardResults results = store.run({100, 100, false}, config, 2);
+    ASSERT_EQ(results.folds.size(), 9u);
+    
+    // Buy at the close of bar 99 and hold to the end
+    Backtester buyAndHold(config.initialCapital, config.slippage, config.latency);
+    buyAndHold.setSignals(store.slice(0, 99, 1000));
+    buyAndHold.runBacktest();
+    const auto& expected = buyAndHold.getEquity();
+    
+    ASSERT_EQ(results.equity.size(), 900u);
+    ASSERT_EQ(results.timestamps.size(), 900u);
+    EXPECT_EQ(results.timestamps.front(), timestamps[100]);
+    for (size_t i = 0; i < results.equity.size(); ++i) {
+        ASSERT_DOUBLE_EQ(results.equity[i], expected[i + 1]) << "bar " << 100 + i;
+    }
+    EXPECT_DOUBLE_EQ(results.results.finalEquity, buyAndHold.getResults().finalEquity);
+    EXPECT_EQ(results.results.totalTrades, 1);
+    
+    // Roughly 10000 * 1.001^900 less one entry's slippage and share rounding
+    EXPECT_NEAR(results.results.finalEquity, 10000.0 * std::pow(1.001, 900) / 1.0005, 0.01 * 24560.0);
+    
+    // Each fold includes the move into its first test bar, which outweighs
+    // the entry slippage
+    for (const WalkForwardFold& fold : results.folds) {
+        ASSERT_EQ(fold.equity.size(), fold.testEnd - fold.testBegin);
+        EXPECT_GT(fold.equity.front(), config.initialCapital) << "fold at " << fold.testBegin;
+    }
+}
+
+TEST(WalkForward, StitchedCurveTradesChosenCandidatesBackToBack) {
+    std::vector<SignalFrame> frames;
+    for (uint64_t seed = 1; seed <= 4; ++seed) {
+        frames.push_back(test::randomFrame(3000, seed, 0.03 * static_cast<double>(seed)));
+    }
+    const Candidates candidates = candidatesOf(frames);
+    const WalkForward store = candidates.store();
+    SweepConfig config;
+    config.latency = 2.5;
+    const WalkForwardResults results = store.run({300, 200, false}, config, 2);
+    ASSERT_FALSE(results.folds.empty());
+    
+    // Bar i trades the signal of the fold whose test window holds bar i + 1
+    const size_t size = candidates.prices.size();
+    const size_t first = results.folds.front().testBegin - 1;
+    std::vector<int64_t> timestamps(candidates.timestamps.begin() + first, candidates.timestamps.end());
+    std::vector<double> prices(candidates.prices.begin() + first, candidates.prices.end());
+    std::vector<int8_t> signals;
+    for (size_t i = first; i < size; ++i) {
+        size_t k = 0;
+        while (k + 1 < results.folds.size() && results.folds[k].testEnd <= std::min(i + 1, size - 1)) {
+            ++k;
+        }
+        signals.push_back(candidates.signals[results.folds[k].candidate * size + i]);
+    }
+    Backtester expected(config.initialCapital, config.slippage, config.latency);
+    expected.setSignals(SignalFrame(std::move(timestamps), std::move(prices), std::move(signals)));
+    expected.runBacktest();
+    
+    ASSERT_EQ(results.equity.size(), size - first - 1);
+    for (size_t i = 0; i < results.equity.size(); ++i) {
+        ASSERT_DOUBLE_EQ(results.equity[i], expected.getEquity()[i + 1]) << "bar " << first + 1 + i;
+    }
+    EXPECT_EQ(results.results.totalTrades, expected.getResults().totalTrades);
+    EXPECT_DOUBLE_EQ(results.results.sharpeRatio, expected.getResults().sharpeRatio);
+}
+
+} // namespace
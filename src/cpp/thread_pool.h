@@ -0,0 +1,94 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fixed-size pool of worker threads
+ */
+class ThreadPool {
+public:
+    /**
+     * Constructor
+     * 
+     * @param numThreads Number of worker threads (0 = one per hardware thread)
+     */
+    explicit ThreadPool(size_t numThreads = 0);
+    
+    /**
+     * Finish queued tasks and join the workers
+     */
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /**
+     * Get the number of worker threads
+     * 
+     * @return Number of workers
+     */
+    size_t size() const { return m_workers.size(); }
+    
+    /**
+     * Queue a task
+     * 
+     * @param task Callable taking no arguments
+     * @return Future for the task's result (rethrows the task's exception)
+     */
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& task) {
+        using Result = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.emplace([packaged] { (*packaged)(); });
+        }
+        m_condition.notify_one();
+        return future;
+    }
+    
+    /**
+     * Run body(i) for every i in [0, count) across the pool and wait
+     * 
+     * Indices are handed out dynamically, so uneven iterations balance
+     * across workers. The first exception thrown by body is rethrown.
+     * 
+     * @param count Number of iterations
+     * @param body Callable taking the iteration index
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+    
+    /**
+     * Run body(i, slot) for every i in [0, count) across the pool and wait
+     * 
+     * Like parallelFor, but also passes a slot in [0, size()) that no two
+     * concurrently running iterations share, for per-worker state such as
+     * scratch buffers or arenas.
+     * 
+     * @param count Number of iterations
+     * @param body Callable taking the iteration index and the slot
+     */
+    void parallelForSlots(size_t count, const std::function<void(size_t, size_t)>& body);
+    
+private:
+    void workerLoop();
+    
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stop;
+};
+
+#endif // THREAD_POOL_H
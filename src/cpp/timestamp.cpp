@@ -0,0 +1,190 @@
+#include "timestamp.h"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr int64_t kNanosPerSecond = 1000000000LL;
+constexpr int64_t kSecondsPerDay = 86400;
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's algorithm)
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int64_t>(yoe) + era * 400 + (month <= 2);
+}
+
+// Number of days in a month of the proleptic Gregorian calendar
+int daysInMonth(int year, int month) {
+    static const int kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : kDays[month - 1];
+}
+
+// Read exactly `count` digits starting at p
+bool readDigits(const char*& p, const char* last, int count, int& value) {
+    if (last - p < count) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < count; ++i, ++p) {
+        if (*p < '0' || *p > '9') {
+            return false;
+        }
+        value = value * 10 + (*p - '0');
+    }
+    return true;
+}
+
+bool expect(const char*& p, const char* last, char c) {
+    if (p == last || *p != c) {
+        return false;
+    }
+    ++p;
+    return true;
+}
+
+} // namespace
+
+bool parseTimestamp(const char* first, const char* last, int64_t& nanos) {
+    // Trim blanks and quotes
+    while (first != last && (*first == ' ' || *first == '"')) {
+        ++first;
+    }
+    while (last != first && (last[-1] == ' ' || last[-1] == '"')) {
+        --last;
+    }
+    if (first == last) {
+        return false;
+    }
+
+    // Integer epoch nanoseconds
+    int64_t epoch = 0;
+    auto result = std::from_chars(first, last, epoch);
+    if (result.ec == std::errc() && result.ptr == last) {
+        nanos = epoch;
+        return true;
+    }
+
+    const char* p = first;
+    int year = 0, month = 0, day = 0;
+    if (!readDigits(p, last, 4, year) || !expect(p, last, '-') ||
+        !readDigits(p, last, 2, month) || !expect(p, last, '-') ||
+        !readDigits(p, last, 2, day)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return false;
+    }
+
+    int hour = 0, minute = 0, second = 0;
+    int64_t fraction = 0;
+    int64_t offsetSeconds = 0;
+
+    if (p != last && (*p == ' ' || *p == 'T')) {
+        ++p;
+        if (!readDigits(p, last, 2, hour) || !expect(p, last, ':') ||
+            !readDigits(p, last, 2, minute)) {
+            return false;
+        }
+        if (p != last && *p == ':') {
+            ++p;
+            if (!readDigits(p, last, 2, second)) {
+                return false;
+            }
+        }
+        if (p != last && *p == '.') {
+            ++p;
+            int digits = 0;
+            while (p != last && *p >= '0' && *p <= '9') {
+                if (digits < 9) {
+                    fraction = fraction * 10 + (*p - '0');
+                    ++digits;
+                }
+                ++p;
+            }
+            for (; digits < 9; ++digits) {
+                fraction *= 10;
+            }
+        }
+        if (hour > 23 || minute > 59 || second > 60) {
+            return false;
+        }
+
+        // Timezone designator
+        if (p != last && *p == 'Z') {
+            ++p;
+        } else if (p != last && (*p == '+' || *p == '-')) {
+            int sign = *p == '-' ? -1 : 1;
+            ++p;
+            int offsetHours = 0, offsetMinutes = 0;
+            if (!readDigits(p, last, 2, offsetHours)) {
+                return false;
+            }
+            expect(p, last, ':');
+            if (!readDigits(p, last, 2, offsetMinutes)) {
+                return false;
+            }
+            offsetSeconds = sign * (offsetHours * 3600 + offsetMinutes * 60);
+        }
+    }
+
+    if (p != last) {
+        return false;
+    }
+
+    int64_t seconds = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * kSecondsPerDay
+                    + hour * 3600 + minute * 60 + second - offsetSeconds;
+    nanos = seconds * kNanosPerSecond + fraction;
+    return true;
+}
+
+int64_t secondsToNanos(double seconds) {
+    return std::llround(seconds * static_cast<double>(kNanosPerSecond));
+}
+
+std::string formatTimestamp(int64_t nanos) {
+    int64_t seconds = nanos / kNanosPerSecond;
+    int64_t fraction = nanos % kNanosPerSecond;
+    if (fraction < 0) {
+        fraction += kNanosPerSecond;
+        --seconds;
+    }
+    int64_t days = seconds / kSecondsPerDay;
+    int64_t secondOfDay = seconds % kSecondsPerDay;
+    if (secondOfDay < 0) {
+        secondOfDay += kSecondsPerDay;
+        --days;
+    }
+
+    int64_t year = 0;
+    unsigned month = 0, day = 0;
+    civilFromDays(days, year, month, day);
+
+    char buffer[48];
+    int length = std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02u %02d:%02d:%02d",
+                               static_cast<long long>(year), month, day,
+                               static_cast<int>(secondOfDay / 3600),
+                               static_cast<int>((secondOfDay / 60) % 60),
+                               static_cast<int>(secondOfDay % 60));
+    if (fraction != 0) {
+        std::snprintf(buffer + length, sizeof(buffer) - length, ".%09lld", static_cast<long long>(fraction));
+    }
+    return buffer;
+}
@@ -0,0 +1,40 @@
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Parse a timestamp into nanoseconds since the Unix epoch (UTC)
+ *
+ * Accepts the formats pandas writes for datetime columns and indexes:
+ * "YYYY-MM-DD", "YYYY-MM-DD HH:MM[:SS[.fraction]]" (or with a 'T'
+ * separator), optionally followed by 'Z' or a "+HH:MM" / "-HHMM" offset.
+ * A plain integer is taken as nanoseconds since the epoch.
+ *
+ * @param first Start of the text
+ * @param last End of the text
+ * @param nanos Parsed value (only written on success)
+ * @return True if the text is a valid timestamp
+ */
+bool parseTimestamp(const char* first, const char* last, int64_t& nanos);
+
+/**
+ * Convert a duration in seconds to nanoseconds
+ * 
+ * @param seconds Duration in seconds
+ * @return Duration rounded to the nearest nanosecond
+ */
+int64_t secondsToNanos(double seconds);
+
+/**
+ * Format nanoseconds since the epoch as "YYYY-MM-DD HH:MM:SS" (UTC)
+ *
+ * A fractional part is appended only when the value has sub-second precision.
+ *
+ * @param nanos Nanoseconds since the Unix epoch
+ * @return Formatted timestamp
+ */
+std::string formatTimestamp(int64_t nanos);
+
+#endif // TIMESTAMP_H
@@ -0,0 +1,42 @@
+#ifndef TRADE_RECORD_H
+#define TRADE_RECORD_H
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Direction of a trade
+ */
+enum class Side : uint8_t {
+    Sell = 0,
+    Buy = 1
+};
+
+/**
+ * Name of a trade direction ("BUY" or "SELL"), for text output only
+ */
+inline const char* sideName(Side side) {
+    return side == Side::Buy ? "BUY" : "SELL";
+}
+
+/**
+ * Fixed-size trade record
+ *
+ * Trivially copyable with no heap-allocated fields or implicit padding, so
+ * trade buffers can be bulk-copied, written to or mapped from disk as is,
+ * and handed to NumPy as a structured array.
+ */
+struct TradeRecord {
+    int64_t timestamp;    // Nanoseconds since the Unix epoch
+    double price;         // Execution price after slippage
+    double value;         // shares * price
+    int32_t shares;
+    Side side;
+    uint8_t reserved[3];  // Zero; keeps the layout explicit
+};
+
+static_assert(std::is_trivially_copyable<TradeRecord>::value, "TradeRecord must be trivially copyable");
+static_assert(std::is_standard_layout<TradeRecord>::value, "TradeRecord must be standard layout");
+static_assert(sizeof(TradeRecord) == 32, "TradeRecord must be 32 bytes");
+
+#endif // TRADE_RECORD_H
@@ -1,18 +1,19 @@
 #include "trade_simulator.h"
+#include "timestamp.h"
 #include <algorithm>
 #include <cmath>
 
-TradeSimulator::TradeSimulator(double slippage, double latency)
-    : m_slippage(slippage), m_latency(latency) {}
+TradeSimulator::TradeSimulator(double slippage, double latency, double initialCapital)
+    : m_slippage(slippage), m_latency(latency), m_initialCapital(initialCapital) {}
 
 double TradeSimulator::calculateBuyPrice(double basePrice) const {
     // Apply slippage to buy price (higher)
-    return basePrice * (1.0 + m_slippage);
+    return ProportionalSlippage{m_slippage}.buyPrice(basePrice);
 }
 
 double TradeSimulator::calculateSellPrice(double basePrice) const {
     // Apply slippage to sell price (lower)
-    return basePrice * (1.0 - m_slippage);
+    return ProportionalSlippage{m_slippage}.sellPrice(basePrice);
 }
 
 Signal TradeSimulator::applyLatency(const Signal& original, const std::vector<Signal>& signals, size_t currentIndex) const {
@@ -20,12 +21,11 @@ Signal TradeSimulator::applyLatency(const Signal& original, const std::vector<Si
         return original;
     }
     
-    // Calculate how many steps to delay
-    // Assume each step is 0.1 seconds for simplicity
-    size_t latencySteps = static_cast<size_t>(m_latency * 10);
-    
-    // Get the delayed signal
-    size_t delayedIndex = std::min(currentIndex + latencySteps, signals.size() - 1);
+    // Find the first signal at or after the original time plus latency
+    const int64_t fillTime = original.timestamp + secondsToNanos(m_latency);
+    auto fill = std::lower_bound(signals.begin() + currentIndex, signals.end(), fillTime,
+                                 [](const Signal& signal, int64_t time) { return signal.timestamp < time; });
+    size_t delayedIndex = std::min(static_cast<size_t>(fill - signals.begin()), signals.size() - 1);
     
     // Create a new signal with the original timestamp but delayed price
     Signal delayedSignal = original;
@@ -34,54 +34,45 @@ Signal TradeSimulator::applyLatency(const Signal& original, const std::vector<Si
     return delayedSignal;
 }
 
-std::vector<Trade> TradeSimulator::simulateTrades(const std::vector<Signal>& signals) const {
-    std::vector<Trade> trades;
+double TradeSimulator::applyLatency(const SignalFrame& signals, size_t currentIndex) const {
+    if (m_latency <= 0.0 || signals.empty() || currentIndex >= signals.size() - 1) {
+        return signals.price(currentIndex);
+    }
+    
+    // Find the first row at or after the signal time plus latency
+    const int64_t fillTime = signals.timestamp(currentIndex) + secondsToNanos(m_latency);
+    size_t delayedIndex = std::min(signals.seek(fillTime, currentIndex), signals.size() - 1);
+    return signals.price(delayedIndex);
+}
+
+std::vector<TradeRecord> TradeSimulator::simulateTrades(const std::vector<Signal>& signals) const {
+    return simulateTrades(SignalFrame::fromSignals(signals));
+}
+
+std::vector<TradeRecord> TradeSimulator::simulateTrades(const SignalFrame& signals) const {
+    std::vector<TradeRecord> trades;
     
     if (signals.empty()) {
         return trades;
     }
     
-    int currentPosition = 0;
-    int lastSignal = 0;
+    // Trades only happen where the signal changes
+    std::vector<size_t> changes(countSignalChanges(signals.signals(), signals.size(), 0));
+    findSignalChanges(signals.signals(), signals.size(), 0, changes.data());
+    trades.reserve(changes.size());
     
-    for (size_t i = 0; i < signals.size(); ++i) {
-        // Apply latency to get effective signal
-        Signal effectiveSignal = applyLatency(signals[i], signals, i);
-        
-        // If signal has changed, execute a trade
-        if (effectiveSignal.signal != lastSignal) {
-            if (effectiveSignal.signal == 1 && currentPosition == 0) {
-                // Buy signal
-                double tradePrice = calculateBuyPrice(effectiveSignal.price);
-                int shares = static_cast<int>(10000.0 / tradePrice);  // Simplified position sizing
-                
-                Trade trade;
-                trade.timestamp = effectiveSignal.timestamp;
-                trade.action = "BUY";
-                trade.shares = shares;
-                trade.price = tradePrice;
-                trade.value = shares * tradePrice;
-                
-                trades.push_back(trade);
-                currentPosition = shares;
-            } else if (effectiveSignal.signal == 0 && currentPosition > 0) {
-                // Sell signal
-                double tradePrice = calculateSellPrice(effectiveSignal.price);
-                
-                Trade trade;
-                trade.timestamp = effectiveSignal.timestamp;
-                trade.action = "SELL";
-                trade.shares = currentPosition;
-                trade.price = tradePrice;
-                trade.value = currentPosition * tradePrice;
-                
-                trades.push_back(trade);
-                currentPosition = 0;
-            }
-            
-            lastSignal = effectiveSignal.signal;
-        }
+    Account account{m_initialCapital, 0};
+    auto onFill = [&trades](const TradeRecord& trade) { trades.push_back(trade); };
+    
+    const int64_t latencyNanos = secondsToNanos(m_latency);
+    if (latencyNanos > 0) {
+        ExecutionEngine<ProportionalSlippage, SearchLatency, AllInSizing> engine(
+            ProportionalSlippage{m_slippage}, SearchLatency(latencyNanos));
+        engine.runChanges(signals, account, changes.data(), changes.size(), onFill, nullptr);
+    } else {
+        ExecutionEngine<ProportionalSlippage, NoLatency, AllInSizing> engine(ProportionalSlippage{m_slippage});
+        engine.runChanges(signals, account, changes.data(), changes.size(), onFill, nullptr);
     }
     
     return trades;
-}
\ No newline at end of file
+}
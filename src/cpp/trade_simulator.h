@@ -2,10 +2,13 @@
 #define TRADE_SIMULATOR_H
 
 #include <vector>
-#include "backtester.h"  // For Signal and Trade structures
+#include "backtester.h"  // For Signal, SignalFrame and TradeRecord structures
 
 /**
  * TradeSimulator class for simulating realistic trading conditions
+ * 
+ * Trades are produced by the same ExecutionEngine as Backtester, so both
+ * agree on slippage, latency and position sizing.
  */
 class TradeSimulator {
 public:
@@ -13,9 +16,10 @@ public:
      * Constructor
      * 
      * @param slippage Slippage parameter (0.001 = 0.1%)
-     * @param latency Latency parameter in seconds
+     * @param latency Latency in seconds, resolved against signal timestamps
+     * @param initialCapital Starting cash; each buy spends all available cash
      */
-    TradeSimulator(double slippage, double latency);
+    TradeSimulator(double slippage, double latency, double initialCapital = 10000.0);
     
     /**
      * Calculate buy price with slippage
@@ -36,6 +40,9 @@ public:
     /**
      * Apply latency to a signal
      * 
+     * The signal keeps its time but takes the price of the first signal at
+     * or after its time plus the latency (the last signal if none).
+     * 
      * @param original Original signal
      * @param signals All signals
      * @param currentIndex Current index in signals
@@ -43,17 +50,38 @@ public:
      */
     Signal applyLatency(const Signal& original, const std::vector<Signal>& signals, size_t currentIndex) const;
     
+    /**
+     * Apply latency to a signal in a columnar frame
+     * 
+     * Searches forward from currentIndex in O(log d) time, where d is the
+     * number of rows the latency spans.
+     * 
+     * @param signals Signal frame
+     * @param currentIndex Current row in the frame
+     * @return Price at which the signal is effectively executed
+     */
+    double applyLatency(const SignalFrame& signals, size_t currentIndex) const;
+    
     /**
      * Simulate trades based on signals
      * 
      * @param signals Vector of signals
-     * @return Vector of trades
+     * @return Vector of trade records
+     */
+    std::vector<TradeRecord> simulateTrades(const std::vector<Signal>& signals) const;
+    
+    /**
+     * Simulate trades based on a columnar signal frame
+     * 
+     * @param signals Signal frame
+     * @return Vector of trade records
      */
-    std::vector<Trade> simulateTrades(const std::vector<Signal>& signals) const;
+    std::vector<TradeRecord> simulateTrades(const SignalFrame& signals) const;
     
 private:
     double m_slippage;
     double m_latency;
+    double m_initialCapital;
 };
 
 #endif // TRADE_SIMULATOR_H
\ No newline at end of file
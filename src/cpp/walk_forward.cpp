@@ -0,0 +1,192 @@
+#include "walk_forward.h"
+#include "run_arena.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * Running sums of a candidate's in-sample returns up to a bar
+ *
+ * With x the close-to-close return while long and c = 1 on a signal
+ * change, the net return at slippage s is x - s * c, so its first two
+ * moments follow from these four sums for any slippage.
+ */
+struct ReturnSums {
+    double sum = 0.0;         // Sum of x
+    double sumSq = 0.0;       // Sum of x^2
+    double sumChanged = 0.0;  // Sum of x * c
+    double changes = 0.0;     // Sum of c
+};
+
+/**
+ * Annualized Sharpe ratio of the net returns between two prefix sums, with
+ * the same conventions as MetricsAccumulator::sharpeRatio
+ */
+double windowSharpe(const ReturnSums& from, const ReturnSums& to, size_t count, double slippage) {
+    if (count == 0) {
+        return 0.0;
+    }
+    const double n = static_cast<double>(count);
+    const double changes = to.changes - from.changes;
+    const double sum = (to.sum - from.sum) - slippage * changes;
+    const double sumSq = (to.sumSq - from.sumSq) - 2.0 * slippage * (to.sumChanged - from.sumChanged) +
+                         slippage * slippage * changes;
+    const double mean = sum / n;
+    const double variance = sumSq / n - mean * mean;
+    
+    // A flat window (e.g. a candidate that never trades) has no deviation
+    if (!(variance > 1e-24)) {
+        return 0.0;
+    }
+    return mean / std::sqrt(variance) * std::sqrt(252.0);
+}
+
+} // namespace
+
+WalkForward::WalkForward(size_t size, const int64_t* timestamps, const double* prices, const int8_t* signals,
+                         size_t candidates, std::shared_ptr<const void> owner)
+    : m_size(size),
+      m_candidates(candidates),
+      m_timestamps(timestamps),
+      m_prices(prices),
+      m_signals(signals),
+      m_owner(std::move(owner)) {
+    if (candidates == 0) {
+        throw std::invalid_argument("Walk-forward needs at least one candidate");
+    }
+}
+
+std::vector<WalkForwardFold> WalkForward::makeFolds(const WalkForwardWindows& windows, size_t size) {
+    if (windows.trainBars < 2 || windows.testBars == 0) {
+        throw std::invalid_argument("Walk-forward windows need at least 2 training bars and 1 test bar");
+    }
+    
+    std::vector<WalkForwardFold> folds;
+    for (size_t testBegin = windows.trainBars; testBegin < size; testBegin += windows.testBars) {
+        WalkForwardFold fold;
+        fold.trainBegin = windows.anchored ? 0 : testBegin - windows.trainBars;
+        fold.trainEnd = testBegin;
+        fold.testBegin = testBegin;
+        fold.testEnd = std::min(testBegin + windows.testBars, size);
+        folds.push_back(std::move(fold));
+    }
+    return folds;
+}
+
+SignalFrame WalkForward::slice(size_t candidate, size_t begin, size_t end) const {
+    return SignalFrame(end - begin, m_timestamps + begin, m_prices + begin,
+                       m_signals + candidate * m_size + begin, m_owner);
+}
+
+WalkForwardResults WalkForward::run(const WalkForwardWindows& windows, const SweepConfig& config,
+                                    size_t numThreads) const {
+    WalkForwardResults results;
+    results.folds = makeFolds(windows, m_size);
+    std::vector<WalkForwardFold>& folds = results.folds;
+    if (folds.empty()) {
+        return results;
+    }
+    
+    // A training window [b, e) has returns at bars b + 1 .. e - 1, so its
+    // sums are the prefix at e minus the prefix at b + 1. Only these
+    // boundaries are kept, shared by every fold whose window touches them.
+    std::vector<size_t> boundaries;
+    boundaries.reserve(folds.size() * 2);
+    for (const WalkForwardFold& fold : folds) {
+        boundaries.push_back(fold.trainBegin + 1);
+        boundaries.push_back(fold.trainEnd);
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+    const size_t lastBoundary = boundaries.back();
+    
+    const size_t tasks = std::max(m_candidates, folds.size());
+    ThreadPool pool(std::min(numThreads == 0 ? std::thread::hardware_concurrency() : numThreads, tasks));
+    
+    // One pass per candidate over the bars up to the last training window
+    std::vector<ReturnSums> prefix(m_candidates * boundaries.size());
+    pool.parallelFor(m_candidates, [&](size_t c) {
+        const int8_t* signals = m_signals + c * m_size;
+        ReturnSums* out = prefix.data() + c * boundaries.size();
+        ReturnSums sums;
+        size_t next = 0;
+        for (size_t i = 0; i <= lastBoundary; ++i) {
+            // Prefix over returns at bars 1 .. i - 1
+            while (next < boundaries.size() && boundaries[next] == i) {
+                out[next++] = sums;
+            }
+            if (i == 0 || i == lastBoundary) {
+                continue;
+            }
+            const double held = signals[i - 1] != 0 ? m_prices[i] / m_prices[i - 1] - 1.0 : 0.0;
+            const bool changed = signals[i] != signals[i - 1];
+            sums.sum += held;
+            sums.sumSq += held * held;
+            if (changed) {
+                sums.sumChanged += held;
+                sums.changes += 1.0;
+            }
+        }
+    });
+    
+    // Select on the training bars and backtest the test bars, one fold per
+    // task. Each fold enters at the close of its last training bar, so the
+    // move into its first test bar is part of its curve.
+    std::vector<RunArena> arenas(pool.size());
+    pool.parallelForSlots(folds.size(), [&](size_t f, size_t slot) {
+        WalkForwardFold& fold = folds[f];
+        const size_t from = static_cast<size_t>(
+            std::lower_bound(boundaries.begin(), boundaries.end(), fold.trainBegin + 1) - boundaries.begin());
+        const size_t to = static_cast<size_t>(
+            std::lower_bound(boundaries.begin(), boundaries.end(), fold.trainEnd) - boundaries.begin());
+        const size_t count = fold.trainEnd - fold.trainBegin - 1;
+        
+        fold.trainSharpe = -std::numeric_limits<double>::infinity();
+        for (size_t c = 0; c < m_candidates; ++c) {
+            const ReturnSums* sums = prefix.data() + c * boundaries.size();
+            const double sharpe = windowSharpe(sums[from], sums[to], count, config.slippage);
+            if (sharpe > fold.trainSharpe) {
+                fold.trainSharpe = sharpe;
+                fold.candidate = c;
+            }
+        }
+        
+        RunArena& arena = arenas[slot];
+        {
+            Backtester backtester(config.initialCapital, config.slippage, config.latency, &arena);
+            backtester.setSignals(slice(fold.candidate, fold.testBegin - 1, fold.testEnd));
+            backtester.runBacktest();
+            fold.results = backtester.getResults();
+            const std::pmr::vector<double>& equity = backtester.getEquity();
+            fold.equity.assign(equity.begin() + 1, equity.end());
+        }
+        arena.reset();
+    });
+    
+    // Stitch by trading the chosen candidates back to back in one run, so
+    // positions, cash and share rounding carry across fold boundaries: bar i
+    // trades the signal of the fold whose test window holds bar i + 1
+    const size_t first = folds.front().testBegin - 1;
+    const size_t last = folds.back().testEnd;
+    auto signals = std::make_shared<std::vector<int8_t>>(last - first);
+    for (const WalkForwardFold& fold : folds) {
+        const int8_t* candidate = m_signals + fold.candidate * m_size;
+        std::copy(candidate + fold.testBegin - 1, candidate + fold.testEnd - 1,
+                  signals->begin() + static_cast<std::ptrdiff_t>(fold.testBegin - 1 - first));
+    }
+    signals->back() = m_signals[folds.back().candidate * m_size + last - 1];
+    
+    Backtester backtester(config.initialCapital, config.slippage, config.latency);
+    backtester.setSignals(
+        SignalFrame(last - first, m_timestamps + first, m_prices + first, signals->data(), signals));
+    backtester.runBacktest();
+    results.results = backtester.getResults();
+    const std::pmr::vector<double>& equity = backtester.getEquity();
+    results.equity.assign(equity.begin() + 1, equity.end());
+    results.timestamps.assign(m_timestamps + first + 1, m_timestamps + last);
+    return results;
+}
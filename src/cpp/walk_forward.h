@@ -0,0 +1,129 @@
+#ifndef WALK_FORWARD_H
+#define WALK_FORWARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "backtester.h"       // For BacktestResults and SignalFrame
+#include "parameter_sweep.h"  // For SweepConfig
+
+/**
+ * Train/test window layout of a walk-forward run
+ *
+ * Fold k tests bars [trainBars + k * testBars, trainBars + (k + 1) * testBars)
+ * and trains on the trainBars bars before them, or on every bar before them
+ * when anchored. The last test window may be shorter.
+ */
+struct WalkForwardWindows {
+    size_t trainBars = 252;  // Bars in each training window (at least 2)
+    size_t testBars = 63;    // Bars in each out-of-sample window (at least 1)
+    bool anchored = false;   // Grow the training window from the first bar
+};
+
+/**
+ * One walk-forward fold
+ */
+struct WalkForwardFold {
+    size_t trainBegin = 0;        // Training bars [trainBegin, trainEnd)
+    size_t trainEnd = 0;
+    size_t testBegin = 0;         // Out-of-sample bars [testBegin, testEnd)
+    size_t testEnd = 0;
+    size_t candidate = 0;         // Candidate chosen on the training bars
+    double trainSharpe = 0.0;     // Its in-sample score
+    BacktestResults results;      // Backtest of the candidate from bar testBegin - 1
+    std::vector<double> equity;   // Its equity per test bar
+};
+
+/**
+ * Outcome of a walk-forward run
+ */
+struct WalkForwardResults {
+    std::vector<WalkForwardFold> folds;
+    std::vector<int64_t> timestamps;  // Every test bar, in order
+    std::vector<double> equity;       // Stitched out-of-sample equity per test bar
+    BacktestResults results;          // Backtest of the stitched signals
+};
+
+/**
+ * WalkForward class for walk-forward analysis over a set of candidate
+ * signal series (e.g. one per strategy parameter set)
+ *
+ * Each fold picks the candidate with the best Sharpe ratio on its training
+ * bars and backtests that candidate on the following test bars. The
+ * in-sample score is the Sharpe ratio of the candidate's close-to-close
+ * returns while long, net of slippage on each signal change. Its sums are
+ * accumulated once per candidate in a single pass and kept at the window
+ * boundaries only, so every training window, however much it overlaps the
+ * others, is scored in O(1) from two prefix sums.
+ *
+ * Folds run in parallel over the shared, read-only store: each test window
+ * is a SignalFrame borrowing a slice of the columns. Each fold enters at
+ * the close of its last training bar, so its curve includes the move into
+ * its first test bar. The stitched curve is a single backtest of the chosen
+ * candidates' signals back to back, so a position held across a fold
+ * boundary is neither closed nor re-entered and the stitched curve of a
+ * candidate chosen in every fold is that candidate's own backtest.
+ */
+class WalkForward {
+public:
+    /**
+     * Constructor over externally owned columns (no copy)
+     * 
+     * @param size Number of bars
+     * @param timestamps Timestamps in nanoseconds since the Unix epoch
+     * @param prices Prices
+     * @param signals Candidate-major signals: candidate c's signal for bar i
+     *                is signals[c * size + i] (0 = no position/sell, 1 = buy)
+     * @param candidates Number of candidate signal series (at least 1)
+     * @param owner Keeps the column memory alive for the lifetime of the
+     *              scheduler and of the frames it hands out
+     */
+    WalkForward(size_t size, const int64_t* timestamps, const double* prices, const int8_t* signals,
+                size_t candidates, std::shared_ptr<const void> owner);
+    
+    /**
+     * Split the bars into folds
+     * 
+     * @param windows Window layout
+     * @param size Number of bars
+     * @return Folds with their bar ranges set, in time order
+     */
+    static std::vector<WalkForwardFold> makeFolds(const WalkForwardWindows& windows, size_t size);
+    
+    /**
+     * Run every fold
+     * 
+     * @param windows Window layout
+     * @param config Capital, slippage and latency of the out-of-sample
+     *               backtests (the slippage is also charged in-sample)
+     * @param numThreads Number of worker threads (0 = one per hardware thread)
+     * @return Per-fold and stitched results (no folds if the series is
+     *         shorter than one training window plus a bar)
+     */
+    WalkForwardResults run(const WalkForwardWindows& windows, const SweepConfig& config,
+                           size_t numThreads = 0) const;
+    
+    /**
+     * Get one candidate's signals over a range of bars
+     * 
+     * @param candidate Candidate index
+     * @param begin First bar
+     * @param end One past the last bar
+     * @return Frame borrowing the store's columns
+     */
+    SignalFrame slice(size_t candidate, size_t begin, size_t end) const;
+    
+    size_t size() const { return m_size; }
+    size_t candidates() const { return m_candidates; }
+    
+private:
+    size_t m_size;
+    size_t m_candidates;
+    const int64_t* m_timestamps;
+    const double* m_prices;
+    const int8_t* m_signals;
+    std::shared_ptr<const void> m_owner;
+};
+
+#endif // WALK_FORWARD_H
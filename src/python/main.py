@@ -8,6 +8,7 @@ import os
 import sys
 import argparse
 import logging
+import numpy as np
 import pandas as pd
 from datetime import datetime
 import matplotlib.pyplot as plt
@@ -21,7 +22,7 @@ logger = logging.getLogger('trading_platform')
 
 # Import local modules
 from data_ingestion import DataIngestion
-from signal_generation import SignalGenerator
+from signal_generation import SignalGenerator, is_signal_file, read_signal_file, signals_to_arrays
 
 # Import C++ module
 try:
@@ -64,16 +65,19 @@ class TradingPlatform:
             return self.data_ingestion.save_data(data, ticker)
         return None
     
-    def generate_signals(self, price_data_path, model_type='random_forest', ticker='STOCK'):
+    def generate_signals(self, price_data_path, model_type='random_forest', ticker='STOCK', binary=False, save=True):
         """Generate trading signals.
         
         Args:
             price_data_path (str): Path to CSV file with price data
             model_type (str): Type of ML model to use
             ticker (str): Stock ticker symbol
+            binary (bool): Save signals as a binary signal file instead of CSV
+            save (bool): Save signals to disk; if False the DataFrame is returned
             
         Returns:
-            str: Path to the saved signals CSV file
+            str or pd.DataFrame: Path to the saved signals file, or the signals
+                DataFrame when save is False
         """
         # Load price data
         try:
@@ -91,8 +95,13 @@ class TradingPlatform:
         # Generate signals
         signals = self.signal_generator.generate_signals(price_data)
         
+        if not save:
+            return signals
+        
         # Save signals
         if signals is not None:
+            if binary:
+                return self.signal_generator.save_signals_binary(signals, ticker)
             return self.signal_generator.save_signals(signals, ticker)
         return None
     
@@ -100,7 +109,8 @@ class TradingPlatform:
         """Run backtest using C++ engine.
         
         Args:
-            signals_path (str): Path to CSV file with signals
+            signals_path (str or pd.DataFrame): Path to CSV or binary signal file,
+                or a signals DataFrame passed to the engine as NumPy arrays
             initial_capital (float): Initial capital for the backtest
             slippage (float): Slippage model parameter
             latency (float): Latency model parameter in seconds
@@ -114,8 +124,14 @@ class TradingPlatform:
         
         try:
             # Run backtest
-            logger.info(f"Running backtest with signals from {signals_path}")
-            results = cpp.run_backtest(signals_path, initial_capital, slippage, latency)
+            if isinstance(signals_path, pd.DataFrame):
+                logger.info("Running backtest with in-memory signals")
+                timestamps, prices, values = signals_to_arrays(signals_path)
+                results = cpp.run_backtest_arrays(timestamps, prices, values, initial_capital, slippage, latency,
+                                                  include_series=True)
+            else:
+                logger.info(f"Running backtest with signals from {signals_path}")
+                results = cpp.run_backtest(signals_path, initial_capital, slippage, latency, include_series=True)
             
             # Print results
             logger.info(f"Backtest Results:")
@@ -128,19 +144,190 @@ class TradingPlatform:
             logger.error(f"Error running backtest: {str(e)}")
             return None
     
+    def run_model_backtest(self, price_data_path, model_path, initial_capital=10000.0, slippage=0.0005, latency=0.0):
+        """Compute features, predict signals and backtest in one native pass.
+        
+        Args:
+            price_data_path (str): Path to CSV file with price data
+            model_path (str): Model file written by SignalGenerator.export_model
+            initial_capital (float): Initial capital for the backtest
+            slippage (float): Slippage model parameter
+            latency (float): Latency model parameter in seconds
+            
+        Returns:
+            dict: Backtest results
+        """
+        if cpp is None:
+            logger.error("C++ engine not available")
+            return None
+        
+        try:
+            price_data = pd.read_csv(price_data_path, index_col=0, parse_dates=True)
+            timestamps = pd.to_datetime(price_data.index, utc=True)
+            nanos = (timestamps - pd.Timestamp(0, tz='UTC')) // pd.Timedelta(1, 'ns')
+            
+            logger.info(f"Running native backtest with model {model_path}")
+            model = cpp.SignalModel(model_path)
+            results = cpp.run_model_backtest(
+                np.ascontiguousarray(nanos.to_numpy(), dtype=np.int64),
+                np.ascontiguousarray(price_data['Close'].to_numpy(), dtype=np.float64),
+                model, initial_capital, slippage, latency, include_series=True
+            )
+            
+            logger.info(f"Backtest Results:")
+            logger.info(f"  Final Return: {results['final_return']:.2f}%")
+            logger.info(f"  Sharpe Ratio: {results['sharpe_ratio']:.2f}")
+            logger.info(f"  Max Drawdown: {results['max_drawdown']:.2f}%")
+            
+            return results
+        except Exception as e:
+            logger.error(f"Error running model backtest: {str(e)}")
+            return None
+    
+    def run_backtests(self, sources, initial_capital=10000.0, slippage=0.0005, latency=0.0, num_threads=0):
+        """Run independent single-symbol backtests in parallel using the C++ engine.
+        
+        Args:
+            sources (dict or list): Signal file paths or signals DataFrames, either as a
+                list or as a dict keyed by symbol
+            initial_capital (float): Initial capital for each backtest
+            slippage (float): Slippage model parameter
+            latency (float): Latency model parameter in seconds
+            num_threads (int): Worker threads (0 = one per core)
+            
+        Returns:
+            pd.DataFrame: One row per source with its backtest results
+        """
+        if cpp is None:
+            logger.error("C++ engine not available")
+            return None
+        
+        try:
+            names = list(sources.keys()) if isinstance(sources, dict) else None
+            items = list(sources.values()) if isinstance(sources, dict) else list(sources)
+            
+            # DataFrames are passed to the engine as NumPy arrays
+            jobs = [signals_to_arrays(item) if isinstance(item, pd.DataFrame) else str(item) for item in items]
+            
+            logger.info(f"Running {len(jobs)} backtests in parallel")
+            table = cpp.run_backtests(jobs, initial_capital, slippage, latency, num_threads)
+            return pd.DataFrame(table, index=names)
+        except Exception as e:
+            logger.error(f"Error running backtests: {str(e)}")
+            return None
+    
+    def run_parameter_sweep(self, signals_path, initial_capitals, slippages, latencies, num_threads=0):
+        """Run a grid of backtest configurations in parallel using the C++ engine.
+        
+        Args:
+            signals_path (str): Path to CSV or binary signal file
+            initial_capitals (list): Initial capital values
+            slippages (list): Slippage values
+            latencies (list): Latency values in seconds
+            num_threads (int): Worker threads (0 = one per core)
+            
+        Returns:
+            pd.DataFrame: One row per configuration with its backtest results
+        """
+        if cpp is None:
+            logger.error("C++ engine not available")
+            return None
+        
+        try:
+            logger.info(f"Running parameter sweep with signals from {signals_path}")
+            table = cpp.run_parameter_sweep(signals_path, initial_capitals, slippages, latencies, num_threads)
+            return pd.DataFrame(table)
+        except Exception as e:
+            logger.error(f"Error running parameter sweep: {str(e)}")
+            return None
+    
+    def rolling_metrics(self, equity, windows=(20, 60, 252), risk_free_rate=0.0, num_threads=0):
+        """Compute rolling volatility, Sharpe, Sortino and drawdown using the C++ engine.
+        
+        Args:
+            equity (np.ndarray): Equity curve, or a (runs, bars) array of curves
+            windows (tuple): Window lengths in bars
+            risk_free_rate (float): Annual risk-free rate
+            num_threads (int): Worker threads (0 = one per core)
+        
+        Returns:
+            dict: {window: {'volatility', 'sharpe_ratio', 'sortino_ratio', 'drawdown'}}
+                with NumPy arrays shaped like equity
+        """
+        if cpp is None:
+            logger.error("C++ engine not available")
+            return None
+        
+        try:
+            return cpp.rolling_metrics(equity, list(windows), risk_free_rate, num_threads)
+        except Exception as e:
+            logger.error(f"Error computing rolling metrics: {str(e)}")
+            return None
+    
+    def walk_forward(self, timestamps, prices, signals, train_bars=252, test_bars=63, anchored=False,
+                     initial_capital=10000.0, slippage=0.0005, latency=0.0, num_threads=0):
+        """Run a walk-forward analysis over candidate signal series using the C++ engine.
+        
+        Each fold picks the candidate with the best in-sample Sharpe ratio on its
+        training window and backtests it on the following test window, entering at
+        the close of the last training bar. The stitched curve trades the chosen
+        candidates back to back, so positions carry across fold boundaries.
+        
+        Args:
+            timestamps (np.ndarray): Timestamps as datetime64[ns] or int64 nanoseconds
+            prices (np.ndarray): Prices
+            signals (np.ndarray): (candidates, bars) signals, e.g. one row per parameter set
+            train_bars (int): Bars in each training window
+            test_bars (int): Bars in each test window
+            anchored (bool): Grow the training window from the first bar
+            initial_capital (float): Initial capital
+            slippage (float): Slippage parameter
+            latency (float): Latency parameter in seconds
+            num_threads (int): Worker threads (0 = one per core)
+        
+        Returns:
+            dict: Stitched out-of-sample results with 'timestamps', 'equity' and 'folds'
+        """
+        if cpp is None:
+            logger.error("C++ engine not available")
+            return None
+        
+        try:
+            timestamps = np.ascontiguousarray(np.asarray(timestamps).astype('datetime64[ns]').view(np.int64))
+            prices = np.ascontiguousarray(prices, dtype=np.float64)
+            signals = np.ascontiguousarray(signals, dtype=np.int8)
+            results = cpp.walk_forward(timestamps, prices, signals, train_bars, test_bars, anchored,
+                                       initial_capital, slippage, latency, num_threads)
+            logger.info(f"Walk-forward over {len(results['folds'])} folds: "
+                        f"return {results['final_return']:.2f}%, Sharpe {results['sharpe_ratio']:.2f}")
+            return results
+        except Exception as e:
+            logger.error(f"Error running walk-forward analysis: {str(e)}")
+            return None
+    
     def visualize_results(self, signals_path, results):
         """Visualize backtest results.
         
         Args:
-            signals_path (str): Path to CSV file with signals
+            signals_path (str or pd.DataFrame): Path to CSV or binary signal file,
+                or a signals DataFrame
             results (dict): Backtest results
         """
         try:
             # Load signals
-            signals = pd.read_csv(signals_path, parse_dates=['timestamp'])
+            if isinstance(signals_path, pd.DataFrame):
+                signals = signals_path
+            elif is_signal_file(signals_path):
+                signals = read_signal_file(signals_path)
+            else:
+                signals = pd.read_csv(signals_path, parse_dates=['timestamp'])
             
             # Create figure
-            fig, (ax1, ax2) = plt.subplots(2, 1, figsize=(12, 8), sharex=True)
+            series = results.get('series') if results else None
+            if series is not None:
+                fig, (ax1, ax2, ax3) = plt.subplots(3, 1, figsize=(12, 10), sharex=True)
+            else:
+                fig, (ax1, ax2) = plt.subplots(2, 1, figsize=(12, 8), sharex=True)
             
             # Plot price
             ax1.plot(signals['timestamp'], signals['price'], label='Price')
@@ -156,6 +343,13 @@ class TradingPlatform:
             ax2.set_yticks([0, 1])
             ax2.legend()
             
+            # Plot the engine's equity curve (NumPy arrays handed over without copies)
+            if series is not None:
+                ax3.plot(pd.to_datetime(series['timestamps']), series['equity'], label='Equity')
+                ax3.set_title('Equity Curve')
+                ax3.set_ylabel('Equity')
+                ax3.legend()
+            
             # Add backtest results as text
             if results:
                 text = (
@@ -192,12 +386,24 @@ def main():
     parser.add_argument('--skip-download', action='store_true', help='Skip data download')
     parser.add_argument('--skip-signals', action='store_true', help='Skip signal generation')
     parser.add_argument('--price-data', type=str, help='Path to price data CSV')
-    parser.add_argument('--signal-data', type=str, help='Path to signal data CSV')
+    parser.add_argument('--signal-data', type=str, help='Path to signal data CSV or binary signal file')
+    parser.add_argument('--binary-signals', action='store_true', help='Save generated signals as a binary signal file')
+    parser.add_argument('--in-memory', action='store_true', help='Pass generated signals to the engine without writing a signals file')
+    parser.add_argument('--model-file', type=str, help='Exported model file; features, signals and backtest then run natively on the price data')
+    parser.add_argument('--batch-signals', type=str, nargs='+', help='Backtest several signal files in parallel and print a results table')
     args = parser.parse_args()
     
     # Create trading platform
     platform = TradingPlatform()
     
+    # Batch backtests over existing signal files
+    if args.batch_signals:
+        table = platform.run_backtests(args.batch_signals, args.capital, args.slippage, args.latency)
+        if table is not None:
+            table.index = args.batch_signals
+            print(table.to_string())
+        return
+    
     # Data ingestion
     price_data_path = args.price_data
     if not args.skip_download and not price_data_path:
@@ -206,16 +412,22 @@ def main():
             logger.error("Failed to ingest data")
             return
     
+    # Native pipeline with an exported model
+    if args.model_file and price_data_path:
+        platform.run_model_backtest(price_data_path, args.model_file, args.capital, args.slippage, args.latency)
+        return
+    
     # Signal generation
     signals_path = args.signal_data
     if not args.skip_signals and not signals_path and price_data_path:
-        signals_path = platform.generate_signals(price_data_path, args.model, args.ticker)
-        if not signals_path:
+        signals_path = platform.generate_signals(price_data_path, args.model, args.ticker,
+                                                 args.binary_signals, save=not args.in_memory)
+        if signals_path is None:
             logger.error("Failed to generate signals")
             return
     
     # Run backtest
-    if signals_path:
+    if signals_path is not None:
         results = platform.run_backtest(signals_path, args.capital, args.slippage, args.latency)
         if results:
             platform.visualize_results(signals_path, results)
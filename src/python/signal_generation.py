@@ -5,8 +5,10 @@ Uses ML models to predict price movements.
 """
 
 import os
+import sys
 import argparse
 import logging
+import struct
 import numpy as np
 import pandas as pd
 from datetime import datetime, timedelta
@@ -23,6 +25,207 @@ logging.basicConfig(
 )
 logger = logging.getLogger('signal_generation')
 
+# The C++ engine computes the technical indicators when it is available
+try:
+    sys.path.append('build')
+    import quant_cpp_engine as cpp
+except ImportError:
+    cpp = None
+
+# Binary signal file layout (must match src/cpp/signal_file.h)
+SIGNAL_FILE_MAGIC = b'SQSIGNAL'
+SIGNAL_FILE_VERSION = 1
+SIGNAL_FILE_ALIGNMENT = 64
+SIGNAL_FILE_HEADER = struct.Struct('<8sIIQ32sII')   # magic, version, header size, rows, symbol, columns, alignment
+SIGNAL_FILE_COLUMN = struct.Struct('<16sIIQ')       # name, dtype code, item size, offset
+SIGNAL_FILE_DTYPES = {np.dtype('<i8'): 1, np.dtype('<f8'): 2, np.dtype('i1'): 3}
+
+def _align_up(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+def write_signal_file(path, timestamps, prices, signals, symbol=''):
+    """Write signals in the binary columnar format read by the C++ engine.
+    
+    Args:
+        path (str): Output file path
+        timestamps (array-like): Timestamps as int64 nanoseconds since the epoch (UTC)
+        prices (array-like): Prices
+        signals (array-like): Signals (0 or 1)
+        symbol (str): Ticker symbol stored in the header
+    """
+    columns = [
+        ('timestamp', np.ascontiguousarray(timestamps, dtype='<i8')),
+        ('price', np.ascontiguousarray(prices, dtype='<f8')),
+        ('signal', np.ascontiguousarray(signals, dtype='i1')),
+    ]
+    rows = len(columns[0][1])
+    if any(len(values) != rows for _, values in columns):
+        raise ValueError("Signal columns must have the same length")
+    
+    header_size = SIGNAL_FILE_HEADER.size + len(columns) * SIGNAL_FILE_COLUMN.size
+    offsets = []
+    offset = _align_up(header_size, SIGNAL_FILE_ALIGNMENT)
+    for _, values in columns:
+        offsets.append(offset)
+        offset = _align_up(offset + values.nbytes, SIGNAL_FILE_ALIGNMENT)
+    
+    with open(path, 'wb') as f:
+        f.write(SIGNAL_FILE_HEADER.pack(
+            SIGNAL_FILE_MAGIC, SIGNAL_FILE_VERSION, header_size, rows,
+            symbol.encode('utf-8')[:31], len(columns), SIGNAL_FILE_ALIGNMENT
+        ))
+        for (name, values), column_offset in zip(columns, offsets):
+            f.write(SIGNAL_FILE_COLUMN.pack(
+                name.encode('ascii'), SIGNAL_FILE_DTYPES[values.dtype], values.itemsize, column_offset
+            ))
+        for (_, values), column_offset in zip(columns, offsets):
+            f.write(b'\0' * (column_offset - f.tell()))
+            f.write(values.tobytes())
+
+def signals_to_arrays(signals):
+    """Convert a signals DataFrame to the column arrays used by the C++ engine.
+    
+    The arrays have the engine's native dtypes, so passing them to
+    Backtester.load_signals_from_arrays or run_backtest_arrays does not copy.
+    
+    Args:
+        signals (pd.DataFrame): DataFrame with timestamp, price and signal columns
+        
+    Returns:
+        tuple: (int64 epoch-nanosecond timestamps, float64 prices, int8 signals)
+    """
+    timestamps = pd.to_datetime(signals['timestamp'], utc=True)
+    nanos = (timestamps - pd.Timestamp(0, tz='UTC')) // pd.Timedelta(1, 'ns')
+    return (
+        np.ascontiguousarray(nanos.to_numpy(), dtype=np.int64),
+        np.ascontiguousarray(signals['price'].to_numpy(), dtype=np.float64),
+        np.ascontiguousarray(signals['signal'].to_numpy(), dtype=np.int8),
+    )
+
+def is_signal_file(path):
+    """Check whether a file is a binary signal file (by its magic bytes)."""
+    try:
+        with open(path, 'rb') as f:
+            return f.read(len(SIGNAL_FILE_MAGIC)) == SIGNAL_FILE_MAGIC
+    except OSError:
+        return False
+
+def read_signal_file(path):
+    """Read a binary signal file into a DataFrame.
+    
+    Args:
+        path (str): Path to the signal file
+        
+    Returns:
+        pd.DataFrame: DataFrame with timestamp, price and signal columns
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+    
+    magic, version, _, rows, _, column_count, _ = SIGNAL_FILE_HEADER.unpack_from(data, 0)
+    if magic != SIGNAL_FILE_MAGIC or version != SIGNAL_FILE_VERSION:
+        raise ValueError(f"{path} is not a version {SIGNAL_FILE_VERSION} signal file")
+    
+    dtypes = {code: dtype for dtype, code in SIGNAL_FILE_DTYPES.items()}
+    columns = {}
+    for c in range(column_count):
+        name, code, _, offset = SIGNAL_FILE_COLUMN.unpack_from(data, SIGNAL_FILE_HEADER.size + c * SIGNAL_FILE_COLUMN.size)
+        columns[name.rstrip(b'\0').decode('ascii')] = np.frombuffer(data, dtype=dtypes[code], count=rows, offset=offset)
+    
+    return pd.DataFrame({
+        'timestamp': pd.to_datetime(columns['timestamp'], utc=True),
+        'price': columns['price'],
+        'signal': columns['signal'],
+    })
+
+# Indicator columns used as model features
+FEATURE_COLUMNS = [
+    'Returns', 'MA5', 'MA10', 'MA20', 'RSI',
+    'Upper_Band', 'Lower_Band', 'MACD', 'Signal_Line'
+]
+
+# Column order of the C++ indicator feature matrix (must match src/cpp/indicator_engine.h)
+INDICATOR_COLUMNS = [
+    'Returns', 'MA5', 'MA10', 'MA20', 'RSI', 'MA20_std',
+    'Upper_Band', 'Lower_Band', 'EMA12', 'EMA26', 'MACD', 'Signal_Line'
+]
+
+# Exported model file layout (must match src/cpp/signal_model.h)
+MODEL_FILE_MAGIC = b'SQMODEL\0'
+MODEL_FILE_VERSION = 1
+MODEL_FILE_HEADER = struct.Struct('<8sIIIIQii24x')  # magic, version, kind, features, trees, nodes, classes
+MODEL_KIND_LINEAR = 1
+MODEL_KIND_TREE_ENSEMBLE = 2
+MODEL_NODE_DTYPE = np.dtype([('feature', '<i4'), ('right', '<i4'), ('value', '<f8')])
+
+def _flatten_tree(tree, nodes):
+    """Append a fitted scikit-learn tree to nodes in the engine's preorder layout.
+    
+    A split's left child is the node right after it, so only the right
+    child is linked; a leaf stores the probability of the second class.
+    
+    Args:
+        tree (sklearn.tree._tree.Tree): Fitted tree (estimator.tree_)
+        nodes (list): Flattened [feature, right, value] nodes, appended to
+        
+    Returns:
+        int: Index of the tree's root in nodes
+    """
+    root = len(nodes)
+    stack = [(0, None)]  # (tree node, flattened split whose right child it is)
+    while stack:
+        node, parent = stack.pop()
+        if parent is not None:
+            nodes[parent][1] = len(nodes)
+        left = tree.children_left[node]
+        if left == -1:
+            counts = tree.value[node][0]
+            nodes.append([-1, 0, counts[1] / counts.sum()])
+        else:
+            # Visit the left subtree first so it lands right after the split
+            stack.append((tree.children_right[node], len(nodes)))
+            stack.append((left, None))
+            nodes.append([tree.feature[node], 0, tree.threshold[node]])
+    return root
+
+def write_model_file(path, model, scaler, feature_cols):
+    """Export a fitted model in the flattened format read by the C++ SignalModel.
+    
+    Args:
+        path (str): Output file path
+        model: Fitted binary RandomForestClassifier, DecisionTreeClassifier or LogisticRegression
+        scaler (StandardScaler): Fitted scaler applied to the features
+        feature_cols (list): Model inputs, named as in INDICATOR_COLUMNS
+    """
+    if len(model.classes_) != 2:
+        raise ValueError("Only binary classifiers can be exported")
+    columns = np.array([INDICATOR_COLUMNS.index(col) for col in feature_cols], dtype='<u4')
+    blocks = [
+        columns,
+        np.ascontiguousarray(scaler.mean_, dtype='<f8'),
+        np.ascontiguousarray(scaler.scale_, dtype='<f8'),
+    ]
+    
+    if isinstance(model, LogisticRegression):
+        kind, tree_count, node_count = MODEL_KIND_LINEAR, 0, 0
+        blocks.append(np.ascontiguousarray(model.coef_[0], dtype='<f8'))
+        blocks.append(np.ascontiguousarray(model.intercept_[:1], dtype='<f8'))
+    else:
+        estimators = getattr(model, 'estimators_', [model])
+        nodes = []
+        roots = [_flatten_tree(estimator.tree_, nodes) for estimator in estimators]
+        kind, tree_count, node_count = MODEL_KIND_TREE_ENSEMBLE, len(roots), len(nodes)
+        blocks.append(np.array(roots, dtype='<u8'))
+        blocks.append(np.array([tuple(node) for node in nodes], dtype=MODEL_NODE_DTYPE))
+    
+    with open(path, 'wb') as f:
+        f.write(MODEL_FILE_HEADER.pack(
+            MODEL_FILE_MAGIC, MODEL_FILE_VERSION, kind, len(columns), tree_count, node_count,
+            int(model.classes_[0]), int(model.classes_[1])
+        ))
+        for values in blocks:
+            f.write(values.tobytes())
+
 class FeatureEngineering:
     """Generate features from price data for ML models."""
     
@@ -36,14 +239,23 @@ class FeatureEngineering:
         Returns:
             pd.DataFrame: DataFrame with technical indicators
         """
-        # Make a copy to avoid modifying the original dataframe
-        data = df.copy()
-        
         # Ensure we have the expected columns
         required_cols = ['Open', 'High', 'Low', 'Close', 'Volume']
-        if not all(col in data.columns for col in required_cols):
-            logger.error(f"Missing required columns. Expected: {required_cols}, Got: {data.columns}")
-            return data
+        if not all(col in df.columns for col in required_cols):
+            logger.error(f"Missing required columns. Expected: {required_cols}, Got: {df.columns}")
+            return df.copy()
+        
+        # One fused native pass writing straight into the feature matrix
+        if cpp is not None:
+            close = np.ascontiguousarray(df['Close'].to_numpy(), dtype=np.float64)
+            features = np.empty((len(close), len(cpp.INDICATOR_COLUMNS)))
+            cpp.compute_indicators(close, out=features)
+            indicators = pd.DataFrame(features, index=df.index, columns=cpp.INDICATOR_COLUMNS, copy=False)
+            data = pd.concat([df.drop(columns=cpp.INDICATOR_COLUMNS, errors='ignore'), indicators], axis=1)
+            return data.dropna()
+        
+        # Make a copy to avoid modifying the original dataframe
+        data = df.copy()
         
         # Calculate returns
         data['Returns'] = data['Close'].pct_change()
@@ -115,6 +327,8 @@ class SignalGenerator:
         self.output_dir = output_dir
         self.model = None
         self.scaler = StandardScaler()
+        self.feature_cols = None
+        self.indicator_state = None
         os.makedirs(output_dir, exist_ok=True)
         
     def _create_model(self):
@@ -151,10 +365,7 @@ class SignalGenerator:
         data = FeatureEngineering.create_target(data)
         
         # Define features
-        feature_cols = [
-            'Returns', 'MA5', 'MA10', 'MA20', 'RSI', 
-            'Upper_Band', 'Lower_Band', 'MACD', 'Signal_Line'
-        ]
+        feature_cols = list(FEATURE_COLUMNS)
         
         # Check if all feature columns exist
         missing_cols = [col for col in feature_cols if col not in data.columns]
@@ -192,6 +403,7 @@ class SignalGenerator:
             
         # Prepare data
         X_train, X_test, y_train, y_test, feature_cols = self.prepare_data(price_data)
+        self.feature_cols = feature_cols
         
         # Train model
         logger.info(f"Training {self.model_type} model...")
@@ -222,10 +434,7 @@ class SignalGenerator:
         data = FeatureEngineering.add_technical_indicators(price_data)
         
         # Define features
-        feature_cols = [
-            'Returns', 'MA5', 'MA10', 'MA20', 'RSI', 
-            'Upper_Band', 'Lower_Band', 'MACD', 'Signal_Line'
-        ]
+        feature_cols = list(FEATURE_COLUMNS)
         
         # Check if all feature columns exist
         feature_cols = [col for col in feature_cols if col in data.columns]
@@ -251,6 +460,60 @@ class SignalGenerator:
         
         return output
     
+    def start_live(self, price_data=None, checkpoint=None):
+        """Start streaming signal generation with the C++ indicator state.
+        
+        Args:
+            price_data (pd.DataFrame, optional): Price history replayed once to
+                warm up the indicators when there is no checkpoint
+            checkpoint (bytes, optional): Output of live_checkpoint() to resume from
+            
+        Returns:
+            bool: True if the indicator state is ready to produce signals
+        """
+        if cpp is None:
+            logger.error("C++ engine not available")
+            return False
+        
+        if checkpoint is not None:
+            self.indicator_state = cpp.IndicatorState.from_bytes(checkpoint)
+        else:
+            self.indicator_state = cpp.IndicatorState()
+            if price_data is not None:
+                for close in price_data['Close'].to_numpy(dtype=np.float64):
+                    self.indicator_state.update(close)
+        return self.indicator_state.ready
+    
+    def on_bar(self, close):
+        """Generate the signal for one new bar in O(1), independent of history length.
+        
+        Args:
+            close (float): Close price of the new bar
+            
+        Returns:
+            int: Signal (0 or 1), or None while the indicators warm up
+        """
+        if self.model is None or self.indicator_state is None:
+            logger.error("Model not trained or live state not started. Call train() and start_live() first.")
+            return None
+        
+        row = self.indicator_state.update(close)
+        features = pd.DataFrame([row], columns=cpp.INDICATOR_COLUMNS)[FEATURE_COLUMNS]
+        if features.isna().to_numpy().any():
+            return None
+        
+        return int(self.model.predict(self.scaler.transform(features))[0])
+    
+    def live_checkpoint(self):
+        """Serialize the live indicator state so a new process can resume without replaying history.
+        
+        Returns:
+            bytes: Checkpoint for start_live(checkpoint=...)
+        """
+        if self.indicator_state is None:
+            return None
+        return self.indicator_state.to_bytes()
+    
     def save_signals(self, signals, ticker, filename=None):
         """Save the generated signals to a CSV file.
         
@@ -286,6 +549,81 @@ class SignalGenerator:
             logger.error(f"Error saving signals: {str(e)}")
             return None
 
+    def save_signals_binary(self, signals, ticker, filename=None):
+        """Save the generated signals to a binary signal file.
+        
+        The C++ engine memory-maps these files instead of parsing CSV.
+        
+        Args:
+            signals (pd.DataFrame): DataFrame with signals
+            ticker (str): Stock ticker symbol
+            filename (str, optional): Custom filename
+            
+        Returns:
+            str: Path to the saved signal file
+        """
+        if signals is None or signals.empty:
+            logger.error("No signals to save")
+            return None
+        
+        # Generate filename if not provided
+        if filename is None:
+            timestamp = datetime.now().strftime("%Y%m%d")
+            filename = f"{ticker}_signals_{timestamp}.sig"
+            
+        # Ensure the output directory exists
+        os.makedirs(self.output_dir, exist_ok=True)
+        
+        # Generate the full path
+        output_path = os.path.join(self.output_dir, filename)
+        
+        # Save the data
+        try:
+            timestamps, prices, values = signals_to_arrays(signals)
+            write_signal_file(output_path, timestamps, prices, values, ticker)
+            logger.info(f"Signals saved to {output_path}")
+            return output_path
+        except Exception as e:
+            logger.error(f"Error saving signals: {str(e)}")
+            return None
+
+    def export_model(self, ticker, filename=None):
+        """Export the trained model and scaler for native inference by the C++ engine.
+        
+        The C++ SignalModel loads the file and computes features, predicts and
+        backtests without calling back into Python.
+        
+        Args:
+            ticker (str): Stock ticker symbol
+            filename (str, optional): Custom filename
+            
+        Returns:
+            str: Path to the saved model file
+        """
+        if self.model is None:
+            logger.error("Model not trained. Call train() first.")
+            return None
+        
+        # Generate filename if not provided
+        if filename is None:
+            timestamp = datetime.now().strftime("%Y%m%d")
+            filename = f"{ticker}_{self.model_type}_{timestamp}.sqm"
+            
+        # Ensure the output directory exists
+        os.makedirs(self.output_dir, exist_ok=True)
+        
+        # Generate the full path
+        output_path = os.path.join(self.output_dir, filename)
+        
+        # Save the model
+        try:
+            write_model_file(output_path, self.model, self.scaler, self.feature_cols or FEATURE_COLUMNS)
+            logger.info(f"Model exported to {output_path}")
+            return output_path
+        except Exception as e:
+            logger.error(f"Error exporting model: {str(e)}")
+            return None
+
 def main():
     """Main function to run signal generation from command line."""
     parser = argparse.ArgumentParser(description='Generate trading signals')
@@ -293,6 +631,8 @@ def main():
     parser.add_argument('--model', type=str, default='random_forest', choices=['random_forest', 'logistic_regression'], help='ML model to use')
     parser.add_argument('--ticker', type=str, required=True, help='Stock ticker symbol')
     parser.add_argument('--output', type=str, help='Output file name')
+    parser.add_argument('--binary', action='store_true', help='Save signals as a binary signal file instead of CSV')
+    parser.add_argument('--export-model', type=str, help='Also export the trained model under this file name for native inference')
     args = parser.parse_args()
     
     # Load price data
@@ -313,7 +653,14 @@ def main():
     
     # Save signals
     if signals is not None:
-        generator.save_signals(signals, args.ticker, args.output)
+        if args.binary:
+            generator.save_signals_binary(signals, args.ticker, args.output)
+        else:
+            generator.save_signals(signals, args.ticker, args.output)
+    
+    # Export the model for the C++ engine
+    if args.export_model:
+        generator.export_model(args.ticker, args.export_model)
 
 if __name__ == "__main__":
     main()
\ No newline at end of file
@@ -0,0 +1,67 @@
+"""
+Tests that the native indicator kernel matches the pandas implementation.
+"""
+
+import os
+import sys
+import unittest
+from unittest import mock
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+
+try:
+    import numpy as np
+    import pandas as pd
+    import signal_generation
+    from signal_generation import FeatureEngineering
+except ImportError:
+    signal_generation = None
+
+def price_data():
+    """Daily OHLCV bars whose closes include the indicators' edge cases."""
+    rng = np.random.default_rng(17)
+    close = 100.0 * np.cumprod(1.0 + rng.normal(0.0, 0.01, 400))
+    close[100:140] = close[99]                            # Flat: zero MA20_std, 0/0 RSI
+    close[200:230] = close[199] * (1.0 + 0.002 * np.arange(1, 31))  # Only gains: RSI 100
+    close[300:330] = close[299] * (1.0 - 0.002 * np.arange(1, 31))  # Only losses: RSI 0
+    index = pd.date_range('2023-01-02', periods=len(close), freq='B')
+    return pd.DataFrame({
+        'Open': close, 'High': close * 1.01, 'Low': close * 0.99, 'Close': close, 'Volume': 1000.0
+    }, index=index)
+
+@unittest.skipIf(signal_generation is None or signal_generation.cpp is None,
+                 "requires NumPy, pandas, scikit-learn and the built quant_cpp_engine module")
+class IndicatorEngineTest(unittest.TestCase):
+    def test_matches_pandas_indicators(self):
+        df = price_data()
+        native = FeatureEngineering.add_technical_indicators(df)
+        with mock.patch.object(signal_generation, 'cpp', None):
+            expected = FeatureEngineering.add_technical_indicators(df)
+        
+        # Same rows survive dropna(): the NaN warm-up and 0/0 RSI rows agree
+        pd.testing.assert_index_equal(native.index, expected.index)
+        self.assertLess(len(native), len(df) - 19)
+        for column in signal_generation.cpp.INDICATOR_COLUMNS:
+            np.testing.assert_allclose(native[column].to_numpy(), expected[column].to_numpy(),
+                                       rtol=1e-9, atol=1e-9, err_msg=column)
+    
+    def test_flat_and_one_sided_windows(self):
+        close = np.ascontiguousarray(price_data()['Close'].to_numpy())
+        features = signal_generation.cpp.compute_indicators(close)
+        column = signal_generation.cpp.INDICATOR_COLUMNS.index
+        
+        # 20 identical closes have exactly zero deviation; 14 zero changes give 0/0
+        self.assertTrue((features[119:140, column('MA20_std')] == 0.0).all())
+        self.assertTrue(np.isnan(features[113:140, column('RSI')]).all())
+        self.assertFalse(np.isnan(features[140, column('RSI')]))
+        self.assertEqual(features[229, column('RSI')], 100.0)
+        self.assertEqual(features[329, column('RSI')], 0.0)
+    
+    def test_batch_rows_match_single_series(self):
+        close = np.ascontiguousarray(price_data()['Close'].to_numpy())
+        single = signal_generation.cpp.compute_indicators(close)
+        batch = signal_generation.cpp.compute_indicators(np.stack([close, close[::-1].copy()]))
+        np.testing.assert_array_equal(batch[0], single)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,62 @@
+"""
+Tests that exported models predict in the C++ engine as they do in scikit-learn.
+"""
+
+import os
+import sys
+import tempfile
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+
+try:
+    import numpy as np
+    import signal_generation
+    from signal_generation import INDICATOR_COLUMNS, write_model_file
+    from sklearn.ensemble import RandomForestClassifier
+    from sklearn.linear_model import LogisticRegression
+    from sklearn.preprocessing import StandardScaler
+except ImportError:
+    signal_generation = None
+
+FEATURE_COLS = ['Returns', 'MA5', 'MA10', 'MA20', 'RSI', 'Upper_Band', 'Lower_Band', 'MACD', 'Signal_Line']
+
+def feature_matrix(rows, seed):
+    """Random (rows, INDICATOR_COLUMNS) features with a learnable target."""
+    rng = np.random.default_rng(seed)
+    features = rng.normal(0.0, 1.0, (rows, len(INDICATOR_COLUMNS))) * 5.0 + 100.0
+    columns = [INDICATOR_COLUMNS.index(col) for col in FEATURE_COLS]
+    target = (features[:, columns[0]] - features[:, columns[4]] + rng.normal(0.0, 3.0, rows) > 0).astype(int)
+    return features, columns, target
+
+@unittest.skipIf(signal_generation is None or signal_generation.cpp is None,
+                 "requires NumPy, scikit-learn and the built quant_cpp_engine module")
+class SignalModelTest(unittest.TestCase):
+    def assert_predictions_match(self, model):
+        features, columns, target = feature_matrix(3000, 5)
+        scaler = StandardScaler().fit(features[:2000, columns])
+        model.fit(scaler.transform(features[:2000, columns]), target[:2000])
+        
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, 'model.sqm')
+            write_model_file(path, model, scaler, FEATURE_COLS)
+            native = signal_generation.cpp.SignalModel(path)
+        
+        self.assertEqual(native.feature_count, len(FEATURE_COLS))
+        expected = model.predict(scaler.transform(features[:, columns]))
+        np.testing.assert_array_equal(native.predict(features), expected)
+        return native
+    
+    def test_random_forest_matches_sklearn(self):
+        native = self.assert_predictions_match(
+            RandomForestClassifier(n_estimators=50, max_depth=8, random_state=42))
+        self.assertEqual(native.kind, 'tree_ensemble')
+        self.assertEqual(native.tree_count, 50)
+    
+    def test_logistic_regression_matches_sklearn(self):
+        native = self.assert_predictions_match(LogisticRegression(random_state=42))
+        self.assertEqual(native.kind, 'linear')
+        self.assertEqual(native.tree_count, 0)
+
+if __name__ == '__main__':
+    unittest.main()